@@ -1,12 +1,27 @@
 #include "DatabaseManager.h"
 
-#include <iostream>
+#include "ValueFormatter.h"
+#include "../logging/Logger.h"
 
 DatabaseManager::DatabaseManager(const std::string& host, int port, const std::string& user, const std::string& password)
-    : session(mysqlx::SessionSettings(host, port, user, password))
+    : host(host)
+    , port(port)
+    , user(user)
+    , password(password)
+    , session(mysqlx::SessionSettings(host, port, user, password))
 {
 }
 
+std::unique_ptr<mysqlx::Session> DatabaseManager::openSession(const std::string& dbName) const
+{
+    auto workerSession = std::make_unique<mysqlx::Session>(mysqlx::SessionSettings(host, port, user, password));
+
+    if (!dbName.empty())
+        workerSession->sql("USE " + ValueFormatter::quoteIdentifier(dbName)).execute();
+
+    return workerSession;
+}
+
 void DatabaseManager::connectToDatabase(const std::string& dbName)
 {
     session.sql("USE " + dbName).execute();
@@ -40,7 +55,7 @@ std::vector<std::string> DatabaseManager::getViews()
     }
     catch (const mysqlx::Error& err)
     {
-        std::cerr << "Error getting views: " << err.what() << std::endl;
+        LOG_ERROR("Error getting views: " << err.what());
     }
     return views;
 }
@@ -57,7 +72,7 @@ std::vector<std::string> DatabaseManager::getStoredProcedures()
     }
     catch (const mysqlx::Error& err)
     {
-        std::cerr << "Error getting stored procedures: " << err.what() << std::endl;
+        LOG_ERROR("Error getting stored procedures: " << err.what());
     }
     return procedures;
 }
@@ -90,7 +105,7 @@ std::vector<std::string> DatabaseManager::getTableDependencies(const std::string
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting table dependencies: " << e.what() << std::endl;
+        LOG_ERROR("Error getting table dependencies: " << e.what());
     }
     return dependencies;
 }
@@ -125,7 +140,7 @@ bool DatabaseManager::hasCircularDependencies()
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error checking circular dependencies: " << e.what() << std::endl;
+        LOG_ERROR("Error checking circular dependencies: " << e.what());
         return false;
     }
 }
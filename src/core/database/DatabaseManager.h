@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,10 +19,19 @@ public:
     std::vector<std::string> getViews();
     std::vector<std::string> getStoredProcedures();
     std::string getCurrentDatabase();
+    std::string getServerAddress() const { return user + "@" + host + ":" + std::to_string(port); }
     std::vector<std::string> getTableDependencies(const std::string& tableName);
 
     bool hasCircularDependencies();
 
+    // Opens an independent session to the same server, used by background workers
+    std::unique_ptr<mysqlx::Session> openSession(const std::string& dbName) const;
+
 private:
+    std::string host;
+    int port;
+    std::string user;
+    std::string password;
+
     mysqlx::Session session;
 };
@@ -1,7 +1,6 @@
 #include "Query.h"
 #include "TableManager.h"
-
-#include <iostream>
+#include "../logging/Logger.h"
 
 Query::Query(mysqlx::Session& sess, TableManager& tableMgr)
     : session(sess)
@@ -9,10 +8,10 @@ Query::Query(mysqlx::Session& sess, TableManager& tableMgr)
 {
 }
 
-QueryResult Query::execute(const std::string& query)
+QueryResult Query::execute(const std::string& query, const PageCallback& onPage)
 {
     QueryResult resultData;
-    std::cout << "\nExecuting custom query:" << std::endl;
+    LOG_DEBUG("Executing custom query:");
 
     try
     {
@@ -25,16 +24,24 @@ QueryResult Query::execute(const std::string& query)
             resultData.columns.push_back(columnName);
         }
 
+        size_t reported = 0;
         for (const auto& row : result)
         {
             std::vector<std::string> currentRow;
+            currentRow.reserve(resultData.columns.size());
             for (size_t i = 0; i < resultData.columns.size(); ++i)
+                currentRow.push_back(tableManager.valueToString(row[i]));
+            resultData.rows.push_back(std::move(currentRow));
+
+            if (onPage && resultData.rows.size() % ResultRows::PAGE_ROWS == 0)
             {
-                std::string valueStr = tableManager.valueToString(row[i]);
-                currentRow.push_back(valueStr);
+                onPage(resultData, reported);
+                reported = resultData.rows.size();
             }
-            resultData.rows.push_back(currentRow);
         }
+
+        if (onPage && (reported < resultData.rows.size() || resultData.rows.empty()))
+            onPage(resultData, reported);
     }
     catch (const mysqlx::Error& err)
     {
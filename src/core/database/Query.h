@@ -2,6 +2,7 @@
 
 #include "models/QueryResult.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -11,9 +12,13 @@ class TableManager;
 
 class Query
 {
+public:
+    // Called with the rows read so far each time a page fills up and once at the end; rows from firstRow on are new
+    using PageCallback = std::function<void(const QueryResult& rows, size_t firstRow)>;
+
 public:
     Query(mysqlx::Session& sess, TableManager& tableMgr);
-    QueryResult execute(const std::string& query);
+    QueryResult execute(const std::string& query, const PageCallback& onPage = nullptr);
 
 private:
     mysqlx::Session& session;
@@ -0,0 +1,115 @@
+#include "SchemaSnapshot.h"
+#include "Query.h"
+#include "../logging/Logger.h"
+
+#include <unordered_map>
+
+SchemaSnapshot SchemaSnapshot::read(Query& query)
+{
+    SchemaSnapshot snapshot;
+    snapshot.fingerprint = readFingerprint(query);
+    readCatalog(query, "", snapshot);
+    return snapshot;
+}
+
+SchemaSnapshot SchemaSnapshot::read(Query& query, const std::vector<std::string>& tableNames)
+{
+    SchemaSnapshot snapshot;
+    if (!tableNames.empty())
+        readCatalog(query, " AND TABLE_NAME IN (" + quoteList(tableNames) + ")", snapshot);
+    return snapshot;
+}
+
+void SchemaSnapshot::readCatalog(Query& query, const std::string& condition, SchemaSnapshot& snapshot)
+{
+    auto columns = query.execute("SELECT c.TABLE_NAME, c.COLUMN_NAME, c.COLUMN_TYPE "
+                                 "FROM INFORMATION_SCHEMA.COLUMNS c "
+                                 "JOIN INFORMATION_SCHEMA.TABLES t USING (TABLE_SCHEMA, TABLE_NAME) "
+                                 "WHERE TABLE_SCHEMA = DATABASE() AND t.TABLE_TYPE = 'BASE TABLE'" +
+                                 condition + " ORDER BY TABLE_NAME, c.ORDINAL_POSITION");
+
+    // Table name to index, and table plus column name to the column
+    std::unordered_map<std::string, size_t> tableIndex;
+    std::unordered_map<std::string, Column*> columnIndex;
+
+    for (const auto& row : columns.rows)
+    {
+        auto [it, inserted] = tableIndex.try_emplace(row[0], snapshot.tables.size());
+        if (inserted)
+            snapshot.tables.push_back({row[0], {}});
+
+        Column column;
+        column.name = row[1];
+        column.type = row[2];
+        snapshot.tables[it->second].columns.push_back(std::move(column));
+    }
+
+    for (auto& table : snapshot.tables)
+    {
+        for (auto& column : table.columns)
+            columnIndex[table.name + '\0' + column.name] = &column;
+    }
+
+    auto keys = query.execute("SELECT TABLE_NAME, COLUMN_NAME, CONSTRAINT_NAME = 'PRIMARY', REFERENCED_TABLE_NAME IS NOT NULL, "
+                              "REFERENCED_TABLE_NAME, REFERENCED_COLUMN_NAME "
+                              "FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE "
+                              "WHERE TABLE_SCHEMA = DATABASE() "
+                              "AND (CONSTRAINT_NAME = 'PRIMARY' OR REFERENCED_TABLE_NAME IS NOT NULL)" +
+                              condition + " ORDER BY TABLE_NAME, CONSTRAINT_NAME, ORDINAL_POSITION");
+
+    for (const auto& row : keys.rows)
+    {
+        auto it = columnIndex.find(row[0] + '\0' + row[1]);
+        if (it == columnIndex.end())
+            continue;
+
+        Column& column = *it->second;
+        if (row[2] != "0")
+            column.isPrimaryKey = true;
+
+        // A column in several foreign keys shows the first one
+        if (row[3] != "0" && !column.isForeignKey)
+        {
+            column.isForeignKey = true;
+            column.referencedTable = row[4];
+            column.referencedColumn = row[5];
+        }
+    }
+
+    LOG_INFO("Read schema with " << snapshot.tables.size() << " tables and " << columns.rows.size() << " columns");
+}
+
+std::string SchemaSnapshot::readFingerprint(Query& query)
+{
+    auto result = query.execute("SELECT "
+                                "(SELECT CONCAT(COUNT(*), '-', COALESCE(SUM(CRC32(CONCAT_WS('|', TABLE_NAME, COLUMN_NAME, "
+                                "COLUMN_TYPE, ORDINAL_POSITION))), 0)) "
+                                "FROM INFORMATION_SCHEMA.COLUMNS WHERE TABLE_SCHEMA = DATABASE()), "
+                                "(SELECT CONCAT(COUNT(*), '-', COALESCE(SUM(CRC32(CONCAT_WS('|', TABLE_NAME, COLUMN_NAME, "
+                                "CONSTRAINT_NAME, REFERENCED_TABLE_NAME, REFERENCED_COLUMN_NAME))), 0)) "
+                                "FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE WHERE TABLE_SCHEMA = DATABASE())");
+
+    if (result.rows.empty() || result.rows[0].size() < 2)
+        return "";
+    return result.rows[0][0] + "/" + result.rows[0][1];
+}
+
+std::string SchemaSnapshot::quoteList(const std::vector<std::string>& values)
+{
+    std::string result;
+    for (const auto& value : values)
+    {
+        if (!result.empty())
+            result += ", ";
+
+        result += '\'';
+        for (char c : value)
+        {
+            if (c == '\'' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        result += '\'';
+    }
+    return result;
+}
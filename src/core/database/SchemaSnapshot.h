@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Query;
+
+// Tables, columns and key constraints of the current schema, read with two bulk INFORMATION_SCHEMA queries
+// instead of lookups per column. The fingerprint is a one-row digest of the same catalog rows, comparing it
+// with a stored one tells whether a cached snapshot is still current without reading the schema again.
+class SchemaSnapshot
+{
+public:
+    struct Column
+    {
+        std::string name;
+        std::string type;
+        bool isPrimaryKey = false;
+        bool isForeignKey = false;
+        std::string referencedTable;
+        std::string referencedColumn;
+    };
+
+    struct Table
+    {
+        std::string name;
+        std::vector<Column> columns;
+    };
+
+public:
+    // Base tables in name order, columns in definition order. Views are left out, the same as in the table list
+    // the diagram was always built from.
+    static SchemaSnapshot read(Query& query);
+    // Only the named tables, without a fingerprint; foreign keys may still reference tables left out
+    static SchemaSnapshot read(Query& query, const std::vector<std::string>& tableNames);
+    static std::string readFingerprint(Query& query);
+    // Comma separated string literals for an IN list, quotes and backslashes escaped
+    static std::string quoteList(const std::vector<std::string>& values);
+
+public:
+    std::string fingerprint;
+    std::vector<Table> tables;
+
+private:
+    // Condition is appended to the WHERE clause of both catalog queries, with TABLE_NAME unqualified
+    static void readCatalog(Query& query, const std::string& condition, SchemaSnapshot& snapshot);
+};
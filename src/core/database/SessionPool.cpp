@@ -0,0 +1,112 @@
+#include "SessionPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+size_t SessionPool::workerCount(size_t jobCount)
+{
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    return std::min({jobCount, hardware, MAX_WORKERS});
+}
+
+void SessionPool::forEach(const DatabaseManager* dbManager, const std::string& dbName, size_t jobCount, const Job& job,
+                          const Prepare& prepare, const Ready& ready)
+{
+    if (jobCount == 0)
+    {
+        if (ready)
+            ready();
+        return;
+    }
+
+    std::atomic<size_t> nextJob{0};
+    std::atomic<bool> failed{false};
+
+    size_t workerTotal = workerCount(jobCount);
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t prepared = 0;
+    bool started = !ready;
+
+    auto arrive = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        prepared++;
+        changed.notify_all();
+        changed.wait(lock, [&]() { return started; });
+    };
+
+    auto worker = [&]() {
+        std::unique_ptr<mysqlx::Session> session;
+        try
+        {
+            session = dbManager->openSession(dbName);
+            if (prepare)
+                prepare(*session);
+        }
+        catch (...)
+        {
+            failed = true;
+            arrive();
+            throw;
+        }
+        arrive();
+
+        try
+        {
+            for (size_t index = nextJob++; index < jobCount && !failed; index = nextJob++)
+                job(*session, index);
+
+            session->close();
+        }
+        catch (...)
+        {
+            failed = true;
+            throw;
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (size_t i = 0; i < workerTotal; ++i)
+        workers.push_back(std::async(std::launch::async, worker));
+
+    std::exception_ptr firstError;
+    if (ready)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return prepared == workerTotal; });
+
+        try
+        {
+            ready();
+        }
+        catch (...)
+        {
+            failed = true;
+            firstError = std::current_exception();
+        }
+
+        started = true;
+        changed.notify_all();
+    }
+
+    for (auto& future : workers)
+    {
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            if (!firstError)
+                firstError = std::current_exception();
+        }
+    }
+
+    if (firstError)
+        std::rethrow_exception(firstError);
+}
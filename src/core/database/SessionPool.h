@@ -0,0 +1,27 @@
+#pragma once
+
+#include "DatabaseManager.h"
+
+#include <functional>
+#include <string>
+
+class SessionPool
+{
+public:
+    using Job = std::function<void(mysqlx::Session&, size_t)>;
+    using Prepare = std::function<void(mysqlx::Session&)>;
+    using Ready = std::function<void()>;
+
+public:
+    // Runs jobs [0, jobCount) on a few worker sessions, each session picks the next unclaimed job.
+    // Remaining jobs are abandoned after the first failure, which is rethrown once all workers stopped.
+    // With ready set, jobs wait until every worker has run prepare (or failed to open its session), ready is then
+    // called once on the calling thread, also after failures.
+    static void forEach(const DatabaseManager* dbManager, const std::string& dbName, size_t jobCount, const Job& job,
+                        const Prepare& prepare = nullptr, const Ready& ready = nullptr);
+
+    static size_t workerCount(size_t jobCount);
+
+private:
+    static constexpr size_t MAX_WORKERS = 4;
+};
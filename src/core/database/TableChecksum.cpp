@@ -0,0 +1,128 @@
+#include "TableChecksum.h"
+
+#include "ValueFormatter.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+std::string toLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+} // namespace
+
+TableChecksum::Digest TableChecksum::compute(mysqlx::Session& session, const std::string& tableName,
+                                             const std::vector<std::string>& columns, const std::string& whereClause)
+{
+    std::string query = "SELECT CAST(COUNT(*) AS UNSIGNED), CAST(COALESCE(BIT_XOR(" + rowHashExpression(columns) +
+                        "), 0) AS UNSIGNED) FROM " + ValueFormatter::quoteIdentifier(tableName);
+
+    if (!whereClause.empty())
+        query += " WHERE " + whereClause;
+
+    auto row = session.sql(query).execute().fetchOne();
+
+    Digest digest;
+    if (row)
+    {
+        digest.rows = row[0].get<uint64_t>();
+        digest.hash = row[1].get<uint64_t>();
+    }
+    return digest;
+}
+
+uint64_t TableChecksum::checksumTable(mysqlx::Session& session, const std::string& tableName)
+{
+    auto row = session.sql("CHECKSUM TABLE " + ValueFormatter::quoteIdentifier(tableName)).execute().fetchOne();
+    return row && !row[1].isNull() ? row[1].get<uint64_t>() : 0;
+}
+
+std::map<std::string, std::vector<TableChecksum::ColumnInfo>> TableChecksum::getColumns(mysqlx::Session& session,
+                                                                                  const std::string& dbName)
+{
+    std::map<std::string, std::vector<ColumnInfo>> columns;
+
+    std::string schema = "DATABASE()";
+    if (!dbName.empty())
+    {
+        schema.clear();
+        ValueFormatter::appendQuoted(schema, dbName);
+    }
+
+    auto result = session
+                      .sql("SELECT TABLE_NAME, COLUMN_NAME, DATA_TYPE, EXTRA, COALESCE(COLUMN_DEFAULT, '') "
+                           "FROM INFORMATION_SCHEMA.COLUMNS "
+                           "WHERE TABLE_SCHEMA = " +
+                           schema +
+                           " "
+                           "ORDER BY TABLE_NAME, ORDINAL_POSITION")
+                      .execute();
+
+    for (const auto& row : result.fetchAll())
+    {
+        ColumnInfo column;
+        column.name = row[1].get<std::string>();
+        column.dataType = toLower(row[2].get<std::string>());
+        column.extra = toLower(row[3].get<std::string>());
+        column.defaultValue = toLower(row[4].get<std::string>());
+        columns[row[0].get<std::string>()].push_back(std::move(column));
+    }
+
+    return columns;
+}
+
+std::string TableChecksum::findHighWaterColumn(const std::vector<ColumnInfo>& columns)
+{
+    for (const auto& column : columns)
+    {
+        if (column.extra.find("auto_increment") != std::string::npos)
+            return column.name;
+    }
+
+    auto isTimestamp = [](const ColumnInfo& column) { return column.dataType == "timestamp" || column.dataType == "datetime"; };
+
+    for (const auto& column : columns)
+    {
+        if (isTimestamp(column) && column.extra.find("on update current_timestamp") != std::string::npos)
+            return column.name;
+    }
+
+    for (const auto& column : columns)
+    {
+        if (isTimestamp(column) && column.defaultValue.find("current_timestamp") == 0)
+            return column.name;
+    }
+
+    return "";
+}
+
+std::string TableChecksum::rowHashExpression(const std::vector<std::string>& columns)
+{
+    // CONCAT_WS skips NULLs, so the trailing ISNULL flags keep NULL and '' apart
+    std::string values;
+    std::string nullFlags;
+
+    for (const auto& column : columns)
+    {
+        std::string quoted = ValueFormatter::quoteIdentifier(column);
+        values += ", " + quoted;
+        nullFlags += (nullFlags.empty() ? "" : ", ") + std::string("ISNULL(") + quoted + ")";
+    }
+
+    if (columns.empty())
+        return "0";
+
+    return "CRC32(CONCAT_WS('#'" + values + ", CONCAT(" + nullFlags + ")))";
+}
+
+std::string TableChecksum::keyRangeClause(const std::string& keyColumn, const std::string& firstKey, const std::string& lastKey)
+{
+    std::string clause = ValueFormatter::quoteIdentifier(keyColumn) + " BETWEEN ";
+    ValueFormatter::appendQuoted(clause, firstKey);
+    clause += " AND ";
+    ValueFormatter::appendQuoted(clause, lastKey);
+    return clause;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <mysqlx/xdevapi.h>
+
+class TableChecksum
+{
+public:
+    struct Digest
+    {
+        uint64_t rows = 0;
+        uint64_t hash = 0;
+
+        bool operator==(const Digest& other) const { return rows == other.rows && hash == other.hash; }
+        bool operator!=(const Digest& other) const { return !(*this == other); }
+    };
+
+    struct ColumnInfo
+    {
+        std::string name;
+        std::string dataType;
+        std::string extra;
+        std::string defaultValue;
+    };
+
+public:
+    // Order independent row count and hash computed on the server, only the two numbers cross the wire
+    static Digest compute(mysqlx::Session& session, const std::string& tableName, const std::vector<std::string>& columns,
+                          const std::string& whereClause = "");
+
+    static uint64_t checksumTable(mysqlx::Session& session, const std::string& tableName);
+
+    // Columns of every table in the given (or current) database, in definition order
+    static std::map<std::string, std::vector<ColumnInfo>> getColumns(mysqlx::Session& session, const std::string& dbName = "");
+
+    // Auto-increment column if any, otherwise a timestamp maintained by the server, otherwise empty
+    static std::string findHighWaterColumn(const std::vector<ColumnInfo>& columns);
+
+    static std::string rowHashExpression(const std::vector<std::string>& columns);
+    static std::string keyRangeClause(const std::string& keyColumn, const std::string& firstKey, const std::string& lastKey);
+};
@@ -1,8 +1,8 @@
 #include "TableDataManager.h"
 
 #include "ValueFormatter.h"
+#include "../logging/Logger.h"
 
-#include <iostream>
 #include <sstream>
 
 TableDataManager::TableDataManager(mysqlx::Session& session)
@@ -22,7 +22,7 @@ std::vector<std::string> TableDataManager::getTableNames() const
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting table names: " << e.what() << std::endl;
+        LOG_ERROR("Error getting table names: " << e.what());
         throw;
     }
     return tables;
@@ -40,7 +40,7 @@ std::vector<std::string> TableDataManager::getViewNames() const
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting view names: " << e.what() << std::endl;
+        LOG_ERROR("Error getting view names: " << e.what());
         throw;
     }
     return views;
@@ -58,7 +58,7 @@ std::vector<std::string> TableDataManager::getProcedureNames() const
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting procedure names: " << e.what() << std::endl;
+        LOG_ERROR("Error getting procedure names: " << e.what());
         throw;
     }
     return procedures;
@@ -76,7 +76,7 @@ std::vector<std::string> TableDataManager::getFunctionNames() const
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting function names: " << e.what() << std::endl;
+        LOG_ERROR("Error getting function names: " << e.what());
         throw;
     }
     return functions;
@@ -112,7 +112,7 @@ std::vector<std::string> TableDataManager::getTableInsertStatements(const std::s
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error generating INSERT statements for " << tableName << ": " << e.what() << std::endl;
+        LOG_ERROR("Error generating INSERT statements for " << tableName << ": " << e.what());
         throw;
     }
     return statements;
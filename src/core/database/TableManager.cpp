@@ -31,6 +31,11 @@ bool TableManager::hasTableDependency(const std::string& table1, const std::stri
     return structureManager.hasTableDependency(table1, table2);
 }
 
+TableStructureManager::Neighborhood TableManager::getNeighborhood(const std::vector<std::string>& roots, int hops) const
+{
+    return structureManager.getNeighborhood(roots, hops);
+}
+
 std::vector<std::string> TableManager::getTableNames() const
 {
     return dataManager.getTableNames();
@@ -15,6 +15,7 @@ public:
     std::string getTableCreateStatement(const std::string& tableName) const;
     std::vector<std::string> getOrderedTableNames() const;
     bool hasTableDependency(const std::string& table1, const std::string& table2) const;
+    TableStructureManager::Neighborhood getNeighborhood(const std::vector<std::string>& roots, int hops) const;
 
 public:
     std::vector<std::string> getTableNames() const;
@@ -1,6 +1,9 @@
 #include "TableStructureManager.h"
+#include "SchemaSnapshot.h"
 
-#include <iostream>
+#include "../logging/Logger.h"
+
+#include <algorithm>
 
 TableStructureManager::TableStructureManager(mysqlx::Session& session)
     : session(session)
@@ -22,7 +25,7 @@ std::vector<std::pair<std::string, std::string>> TableStructureManager::getTable
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting table structure: " << e.what() << std::endl;
+        LOG_ERROR("Error getting table structure: " << e.what());
         throw;
     }
     return structure;
@@ -38,15 +41,19 @@ std::string TableStructureManager::getCreateStatement(const std::string& tableNa
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error getting CREATE statement: " << e.what() << std::endl;
+        LOG_ERROR("Error getting CREATE statement: " << e.what());
         throw;
     }
 }
 
 std::vector<std::string> TableStructureManager::getOrderedTableNames() const
+{
+    return getOrderedTableNames(buildDependencyGraph());
+}
+
+std::vector<std::string> TableStructureManager::getOrderedTableNames(std::map<std::string, std::vector<std::string>> graph) const
 {
     std::vector<std::string> orderedTables;
-    auto graph = buildDependencyGraph();
     std::set<std::string> visited;
     std::set<std::string> processed;
 
@@ -65,31 +72,33 @@ std::map<std::string, std::vector<std::string>> TableStructureManager::buildDepe
 
     try
     {
-        auto tablesResult = session.sql("SHOW FULL TABLES WHERE Table_type = 'BASE TABLE'").execute();
-        for (const auto& row : tablesResult.fetchAll())
-        {
-            std::string tableName = row[0].get<std::string>();
-
-            auto depsResult = session
-                                  .sql("SELECT REFERENCED_TABLE_NAME FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE "
-                                       "WHERE TABLE_SCHEMA = DATABASE() "
-                                       "AND TABLE_NAME = '" +
-                                       tableName +
-                                       "' "
-                                       "AND REFERENCED_TABLE_NAME IS NOT NULL")
-                                  .execute();
-
-            std::vector<std::string> deps;
-
-            for (const auto& depRow : depsResult.fetchAll())
-                deps.push_back(depRow[0].get<std::string>());
+        // One pass over the catalog, tables without foreign keys come back once with a NULL reference
+        auto result = session
+                          .sql("SELECT t.TABLE_NAME, k.REFERENCED_TABLE_NAME "
+                               "FROM INFORMATION_SCHEMA.TABLES t "
+                               "LEFT JOIN INFORMATION_SCHEMA.KEY_COLUMN_USAGE k "
+                               "ON k.TABLE_SCHEMA = t.TABLE_SCHEMA AND k.TABLE_NAME = t.TABLE_NAME "
+                               "AND k.REFERENCED_TABLE_SCHEMA = t.TABLE_SCHEMA "
+                               "WHERE t.TABLE_SCHEMA = DATABASE() AND t.TABLE_TYPE = 'BASE TABLE' "
+                               "ORDER BY t.TABLE_NAME, k.CONSTRAINT_NAME, k.ORDINAL_POSITION")
+                          .execute();
 
-            graph[tableName] = deps;
+        for (const auto& row : result.fetchAll())
+        {
+            std::string table = row[0].get<std::string>();
+            auto& deps = graph[table];
+            if (row[1].isNull())
+                continue;
+
+            // Composite keys come back once per column
+            std::string referenced = row[1].get<std::string>();
+            if (referenced != table && std::find(deps.begin(), deps.end(), referenced) == deps.end())
+                deps.push_back(referenced);
         }
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error building dependency graph: " << e.what() << std::endl;
+        LOG_ERROR("Error building dependency graph: " << e.what());
         throw;
     }
 
@@ -119,6 +128,82 @@ void TableStructureManager::performTopologicalSort(const std::string& table, std
     result.push_back(table);
 }
 
+// Reads only the keys touching the tables reached so far, one query per hop, so the cost follows the size of the
+// neighbourhood and not of the schema.
+TableStructureManager::Neighborhood TableStructureManager::getNeighborhood(const std::vector<std::string>& roots, int hops) const
+{
+    Neighborhood neighborhood;
+    std::vector<std::string>& result = neighborhood.tables;
+    std::set<std::string> seen;
+
+    try
+    {
+        auto count = session
+                         .sql("SELECT COUNT(*) FROM INFORMATION_SCHEMA.TABLES "
+                              "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_TYPE = 'BASE TABLE'")
+                         .execute();
+        auto countRow = count.fetchOne();
+        neighborhood.schemaTables = countRow ? countRow[0].get<uint64_t>() : 0;
+
+        if (roots.empty())
+            return neighborhood;
+
+        auto existing = session
+                            .sql("SELECT TABLE_NAME FROM INFORMATION_SCHEMA.TABLES "
+                                 "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_TYPE = 'BASE TABLE' "
+                                 "AND TABLE_NAME IN (" +
+                                 SchemaSnapshot::quoteList(roots) + ")")
+                            .execute();
+
+        std::set<std::string> found;
+        for (const auto& row : existing.fetchAll())
+            found.insert(row[0].get<std::string>());
+
+        for (const auto& root : roots)
+        {
+            if (found.count(root) && seen.insert(root).second)
+                result.push_back(root);
+        }
+
+        size_t levelStart = 0;
+        for (int hop = 0; hop < hops && levelStart < result.size(); ++hop)
+        {
+            size_t levelEnd = result.size();
+            std::vector<std::string> frontier(result.begin() + levelStart, result.end());
+            std::set<std::string> level(frontier.begin(), frontier.end());
+            std::string names = SchemaSnapshot::quoteList(frontier);
+
+            auto keys = session
+                            .sql("SELECT TABLE_NAME, REFERENCED_TABLE_NAME FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE "
+                                 "WHERE TABLE_SCHEMA = DATABASE() AND REFERENCED_TABLE_SCHEMA = TABLE_SCHEMA "
+                                 "AND (TABLE_NAME IN (" +
+                                 names + ") OR REFERENCED_TABLE_NAME IN (" + names +
+                                 ")) "
+                                 "ORDER BY TABLE_NAME, CONSTRAINT_NAME, ORDINAL_POSITION")
+                            .execute();
+
+            // Keys point from referencing to referenced tables, a neighbourhood follows them both ways
+            for (const auto& row : keys.fetchAll())
+            {
+                std::string table = row[0].get<std::string>();
+                std::string referenced = row[1].get<std::string>();
+                if (level.count(table) && seen.insert(referenced).second)
+                    result.push_back(referenced);
+                if (level.count(referenced) && seen.insert(table).second)
+                    result.push_back(table);
+            }
+            levelStart = levelEnd;
+        }
+    }
+    catch (const mysqlx::Error& e)
+    {
+        LOG_ERROR("Error reading table neighbourhood: " << e.what());
+        throw;
+    }
+
+    return neighborhood;
+}
+
 bool TableStructureManager::hasTableDependency(const std::string& table1, const std::string& table2) const
 {
     try
@@ -138,7 +223,7 @@ bool TableStructureManager::hasTableDependency(const std::string& table1, const
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "Error checking table dependency: " << e.what() << std::endl;
+        LOG_ERROR("Error checking table dependency: " << e.what());
         return false;
     }
 }
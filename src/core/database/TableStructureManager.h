@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -8,6 +9,13 @@
 
 class TableStructureManager
 {
+public:
+    struct Neighborhood
+    {
+        std::vector<std::string> tables; // Roots first, then in order of distance
+        size_t schemaTables = 0;         // Base tables in the whole schema
+    };
+
 public:
     explicit TableStructureManager(mysqlx::Session& session);
 
@@ -15,10 +23,16 @@ public:
     std::vector<std::pair<std::string, std::string>> getTableStructure(const std::string& tableName);
     std::string getCreateStatement(const std::string& tableName) const;
     std::vector<std::string> getOrderedTableNames() const;
+    std::vector<std::string> getOrderedTableNames(std::map<std::string, std::vector<std::string>> graph) const;
     bool hasTableDependency(const std::string& table1, const std::string& table2) const;
 
-private:
+    // Tables within the given number of foreign key hops of the roots, following keys in either direction
+    Neighborhood getNeighborhood(const std::vector<std::string>& roots, int hops) const;
+
+    // Every base table with the distinct tables it references, self references left out
     std::map<std::string, std::vector<std::string>> buildDependencyGraph() const;
+
+private:
     void performTopologicalSort(const std::string& table, std::map<std::string, std::vector<std::string>>& graph,
                                 std::set<std::string>& visited, std::set<std::string>& processed,
                                 std::vector<std::string>& result) const;
@@ -44,6 +44,79 @@ std::string ValueFormatter::format(const mysqlx::Value& value)
     }
 }
 
+void ValueFormatter::appendQuoted(std::string& out, std::string_view text)
+{
+    out += '\'';
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '\'':
+            out += "\\'";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\0':
+            out += "\\0";
+            break;
+        default:
+            out += c;
+        }
+    }
+    out += '\'';
+}
+
+void ValueFormatter::appendLiteral(std::string& out, const mysqlx::Value& value)
+{
+    // Unlike format(), numbers keep full precision so dumps restore the exact values
+    switch (value.getType())
+    {
+    case mysqlx::Value::Type::VNULL:
+        out += "NULL";
+        break;
+
+    case mysqlx::Value::Type::BOOL:
+        out += value.get<bool>() ? '1' : '0';
+        break;
+
+    case mysqlx::Value::Type::INT64:
+        out += std::to_string(value.get<int64_t>());
+        break;
+
+    case mysqlx::Value::Type::UINT64:
+        out += std::to_string(value.get<uint64_t>());
+        break;
+
+    case mysqlx::Value::Type::FLOAT:
+    case mysqlx::Value::Type::DOUBLE: {
+        char text[32];
+        snprintf(text, sizeof(text), "%.17g", value.get<double>());
+        out += text;
+        break;
+    }
+
+    default:
+        appendQuoted(out, format(value));
+    }
+}
+
+std::string ValueFormatter::quoteIdentifier(const std::string& name)
+{
+    // Accepts both `table` and `schema.table`
+    std::string quoted = "`";
+    for (char c : name)
+    {
+        if (c == '.')
+            quoted += "`.`";
+        else if (c == '`')
+            quoted += "``";
+        else
+            quoted += c;
+    }
+    return quoted + "`";
+}
+
 std::string ValueFormatter::formatTime(const unsigned char* data, int length)
 {
     char text[9];
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <mysqlx/xdevapi.h>
 
@@ -8,6 +9,9 @@ class ValueFormatter
 {
 public:
     static std::string format(const mysqlx::Value& value);
+    static void appendQuoted(std::string& out, std::string_view text);
+    static void appendLiteral(std::string& out, const mysqlx::Value& value);
+    static std::string quoteIdentifier(const std::string& name);
 
 private:
     static std::string formatTime(const unsigned char* data, int length);
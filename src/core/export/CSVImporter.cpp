@@ -0,0 +1,487 @@
+#include "CSVImporter.h"
+#include "MappedFile.h"
+
+#include "../database/ValueFormatter.h"
+#include "../logging/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <thread>
+
+namespace
+{
+constexpr uint64_t ONES = 0x0101010101010101ULL;
+constexpr uint64_t HIGHS = 0x8080808080808080ULL;
+
+uint64_t broadcast(char c)
+{
+    return ONES * static_cast<unsigned char>(c);
+}
+
+// Non-zero when any byte of the word is zero (may also flag bytes above a zero byte)
+uint64_t zeroBytes(uint64_t word)
+{
+    return (word - ONES) & ~word & HIGHS;
+}
+
+std::string toLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return text;
+}
+
+std::string trim(const std::string& text)
+{
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+        return "";
+
+    size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+} // namespace
+
+bool CSVImporter::importFromCSV(DatabaseManager* dbManager, const std::string& filename, const std::string& tableName, Report& report)
+{
+    return importFromCSV(dbManager, filename, tableName, detectOptions(filename), report);
+}
+
+bool CSVImporter::importFromCSV(DatabaseManager* dbManager, const std::string& filename, const std::string& tableName,
+                                const Options& options, Report& report)
+{
+    report = Report{};
+
+    try
+    {
+        if (tableName.empty())
+            throw std::runtime_error("Target table is not specified");
+
+        // Imports start from the server view, there is no current database to resolve a bare name against
+        if (tableName.find('.') == std::string::npos)
+            throw std::runtime_error("Target table must be given as schema.table: " + tableName);
+
+        MappedFile file(filename);
+
+        auto& session = dbManager->getSession();
+        auto tableColumns = getTableColumns(dbManager, tableName);
+
+        const char* begin = file.view().data();
+        const char* fileEnd = begin + file.size();
+
+        const char* headerEnd = skipRecord(begin, fileEnd, options.delimiter);
+        auto header = readHeader(std::string_view(begin, (headerEnd ? headerEnd : fileEnd) - begin), options);
+        auto mapping = mapColumns(header, tableColumns, options.hasHeader);
+
+        if (mapping.empty())
+            throw std::runtime_error("None of the file columns match the columns of " + tableName);
+
+        std::string insertPrefix = "INSERT INTO " + ValueFormatter::quoteIdentifier(tableName) + " (";
+        for (size_t i = 0; i < mapping.size(); ++i)
+        {
+            if (i > 0)
+                insertPrefix += ", ";
+            insertPrefix += ValueFormatter::quoteIdentifier(mapping[i].tableColumn);
+        }
+        insertPrefix += ") VALUES ";
+
+        if (options.hasHeader)
+            begin = headerEnd ? headerEnd : fileEnd;
+
+        size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        size_t window = BLOCK_SIZE;
+
+        // The file is mapped once, each block is a window over it committed in its own transaction
+        while (begin < fileEnd)
+        {
+            const char* end = static_cast<size_t>(fileEnd - begin) > window ? begin + window : fileEnd;
+            bool lastBlock = end == fileEnd;
+
+            const char* recordsEnd = begin;
+            size_t chunkCount = std::min(workers, std::max<size_t>(1, (end - begin) / MIN_CHUNK_SIZE));
+            auto chunks = splitIntoChunks(begin, end, chunkCount, options.delimiter, lastBlock, recordsEnd);
+
+            // A single record larger than the window, widen it until the record fits
+            if (chunks.empty() && !lastBlock)
+            {
+                window *= 2;
+                continue;
+            }
+            window = BLOCK_SIZE;
+
+            std::vector<std::future<std::vector<std::string>>> pending;
+            for (const auto& chunk : chunks)
+                pending.push_back(std::async(std::launch::async, buildInsertStatements, chunk, std::cref(options),
+                                             std::cref(insertPrefix), std::cref(mapping)));
+
+            size_t windowRows = 0;
+            session.startTransaction();
+            try
+            {
+                for (auto& future : pending)
+                {
+                    for (const auto& stmt : future.get())
+                        windowRows += session.sql(stmt).execute().getAffectedItemsCount();
+                }
+                session.commit();
+                report.committedRows += windowRows;
+            }
+            catch (...)
+            {
+                session.rollback();
+                for (auto& future : pending)
+                {
+                    if (future.valid())
+                        future.wait();
+                }
+                throw;
+            }
+
+            if (lastBlock)
+                break;
+
+            begin = recordsEnd;
+        }
+
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("CSV import error after " << report.committedRows << " committed rows: " << e.what());
+        report.error = e.what();
+        return false;
+    }
+}
+
+bool CSVImporter::isDelimitedFile(const std::string& filename)
+{
+    std::string extension = toLower(std::filesystem::path(filename).extension().string());
+    return extension == ".csv" || extension == ".tsv";
+}
+
+CSVImporter::Options CSVImporter::detectOptions(const std::string& filename)
+{
+    Options options;
+    if (toLower(std::filesystem::path(filename).extension().string()) == ".tsv")
+        options.delimiter = '\t';
+    return options;
+}
+
+std::vector<CSVImporter::ColumnMapping> CSVImporter::mapColumns(const std::vector<std::string>& header,
+                                                                const std::vector<TableColumn>& tableColumns, bool hasHeader)
+{
+    std::vector<ColumnMapping> mapping;
+
+    if (!hasHeader)
+    {
+        for (size_t i = 0; i < std::min(header.size(), tableColumns.size()); ++i)
+            mapping.push_back({i, tableColumns[i].name, tableColumns[i].nullable});
+        return mapping;
+    }
+
+    for (size_t i = 0; i < header.size(); ++i)
+    {
+        std::string name = toLower(trim(header[i]));
+        auto it = std::find_if(tableColumns.begin(), tableColumns.end(), [&name](const TableColumn& column) {
+            return toLower(column.name) == name;
+        });
+
+        if (it != tableColumns.end())
+            mapping.push_back({i, it->name, it->nullable});
+        else
+            LOG_WARNING("CSV column '" << header[i] << "' has no matching table column, skipping");
+    }
+
+    return mapping;
+}
+
+const char* CSVImporter::findSpecial(const char* p, const char* end, char delimiter)
+{
+    const uint64_t delimiterMask = broadcast(delimiter);
+    const uint64_t newlineMask = broadcast('\n');
+    const uint64_t returnMask = broadcast('\r');
+    const uint64_t quoteMask = broadcast('"');
+
+    // Skip eight plain bytes at a time, the byte loop below pins down the exact position
+    while (end - p >= 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+
+        if (zeroBytes(word ^ delimiterMask) | zeroBytes(word ^ newlineMask) | zeroBytes(word ^ returnMask) |
+            zeroBytes(word ^ quoteMask))
+            break;
+
+        p += 8;
+    }
+
+    while (p < end && *p != delimiter && *p != '\n' && *p != '\r' && *p != '"')
+        p++;
+
+    return p;
+}
+
+const char* CSVImporter::parseRecord(const char* p, const char* end, char delimiter, std::vector<Field>& fields)
+{
+    fields.clear();
+
+    while (true)
+    {
+        Field field;
+
+        if (p < end && *p == '"')
+        {
+            const char* start = ++p;
+            while (true)
+            {
+                auto* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+                if (!quote)
+                    throw std::runtime_error("Unterminated quoted field");
+
+                if (quote + 1 < end && quote[1] == '"')
+                {
+                    field.hasEscapedQuotes = true;
+                    p = quote + 2;
+                    continue;
+                }
+
+                field.text = std::string_view(start, quote - start);
+                field.quoted = true;
+                p = quote + 1;
+                break;
+            }
+
+            // Anything between the closing quote and the next separator is ignored
+            while ((p = findSpecial(p, end, delimiter)) < end && *p == '"')
+                p++;
+        }
+        else
+        {
+            const char* start = p;
+            while ((p = findSpecial(p, end, delimiter)) < end && *p == '"')
+                p++;
+
+            field.text = std::string_view(start, p - start);
+        }
+
+        fields.push_back(field);
+
+        if (p >= end)
+            return end;
+
+        if (*p == delimiter)
+        {
+            p++;
+            continue;
+        }
+
+        if (*p == '\r')
+            p++;
+        if (p < end && *p == '\n')
+            p++;
+
+        return p;
+    }
+}
+
+const char* CSVImporter::skipRecord(const char* p, const char* end, char delimiter)
+{
+    while (true)
+    {
+        if (p < end && *p == '"')
+        {
+            p++;
+            while (true)
+            {
+                auto* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+
+                // A quote in the last byte may be the first half of an escaped pair
+                if (!quote || quote + 1 == end)
+                    return nullptr;
+
+                if (quote[1] == '"')
+                {
+                    p = quote + 2;
+                    continue;
+                }
+
+                p = quote + 1;
+                break;
+            }
+        }
+
+        while ((p = findSpecial(p, end, delimiter)) < end && *p == '"')
+            p++;
+
+        if (p >= end)
+            return nullptr;
+
+        if (*p == delimiter)
+        {
+            p++;
+            continue;
+        }
+
+        if (*p == '\r' && ++p == end)
+            return nullptr;
+        if (*p == '\n')
+            p++;
+
+        return p;
+    }
+}
+
+std::vector<CSVImporter::Chunk> CSVImporter::splitIntoChunks(const char* begin, const char* end, size_t chunkCount, char delimiter,
+                                                             bool lastBlock, const char*& recordsEnd)
+{
+    std::vector<Chunk> chunks;
+    const char* chunkStart = begin;
+    const char* p = begin;
+    size_t size = end - begin;
+    size_t nextChunk = 1;
+
+    while (p < end)
+    {
+        const char* recordEnd = skipRecord(p, end, delimiter);
+        if (!recordEnd)
+            break;
+
+        p = recordEnd;
+
+        if (nextChunk < chunkCount && p >= begin + size * nextChunk / chunkCount)
+        {
+            chunks.push_back({chunkStart, p});
+            chunkStart = p;
+
+            while (nextChunk < chunkCount && p >= begin + size * nextChunk / chunkCount)
+                nextChunk++;
+        }
+    }
+
+    // The final record of the file does not need a trailing newline
+    if (lastBlock)
+        p = end;
+
+    if (chunkStart < p)
+        chunks.push_back({chunkStart, p});
+
+    recordsEnd = p;
+    return chunks;
+}
+
+std::vector<std::string> CSVImporter::buildInsertStatements(Chunk chunk, const Options& options, const std::string& insertPrefix,
+                                                            const std::vector<ColumnMapping>& mapping)
+{
+    std::vector<std::string> statements;
+    std::vector<Field> fields;
+    std::string statement;
+    size_t rows = 0;
+
+    const char* p = chunk.begin;
+    while (p < chunk.end)
+    {
+        p = parseRecord(p, chunk.end, options.delimiter, fields);
+
+        if (fields.size() == 1 && !fields[0].quoted && fields[0].text.empty())
+            continue;
+
+        if (rows == 0)
+            statement = insertPrefix;
+        else
+            statement += ", ";
+
+        statement += '(';
+        for (size_t i = 0; i < mapping.size(); ++i)
+        {
+            if (i > 0)
+                statement += ", ";
+
+            if (mapping[i].fileColumn < fields.size())
+                appendField(statement, fields[mapping[i].fileColumn], mapping[i]);
+            else
+                appendMissing(statement, mapping[i]);
+        }
+        statement += ')';
+
+        if (++rows == options.batchRows)
+        {
+            statements.push_back(std::move(statement));
+            statement.clear();
+            rows = 0;
+        }
+    }
+
+    if (rows > 0)
+        statements.push_back(std::move(statement));
+
+    return statements;
+}
+
+void CSVImporter::appendField(std::string& out, const Field& field, const ColumnMapping& column)
+{
+    if (!field.quoted && (field.text == "\\N" || field.text == "NULL"))
+    {
+        out += "NULL";
+        return;
+    }
+
+    // Strict mode rejects '' for numbers and dates, a missing value is left to the column instead. "" stays empty.
+    if (!field.quoted && field.text.empty())
+    {
+        appendMissing(out, column);
+        return;
+    }
+
+    if (!field.hasEscapedQuotes)
+    {
+        ValueFormatter::appendQuoted(out, field.text);
+        return;
+    }
+
+    std::string unescaped;
+    unescaped.reserve(field.text.size());
+
+    for (size_t i = 0; i < field.text.size(); ++i)
+    {
+        if (field.text[i] == '"' && i + 1 < field.text.size() && field.text[i + 1] == '"')
+            i++;
+        unescaped += field.text[i];
+    }
+
+    ValueFormatter::appendQuoted(out, unescaped);
+}
+
+void CSVImporter::appendMissing(std::string& out, const ColumnMapping& column)
+{
+    out += column.nullable ? "NULL" : "DEFAULT";
+}
+
+std::vector<std::string> CSVImporter::readHeader(std::string_view data, const Options& options)
+{
+    constexpr std::string_view BOM = "\xEF\xBB\xBF";
+    if (data.substr(0, BOM.size()) == BOM)
+        data.remove_prefix(BOM.size());
+
+    std::vector<Field> fields;
+    parseRecord(data.data(), data.data() + data.size(), options.delimiter, fields);
+
+    std::vector<std::string> header;
+    for (const auto& field : fields)
+        header.emplace_back(field.text);
+
+    return header;
+}
+
+std::vector<CSVImporter::TableColumn> CSVImporter::getTableColumns(DatabaseManager* dbManager, const std::string& tableName)
+{
+    auto result = dbManager->getSession().sql("DESCRIBE " + ValueFormatter::quoteIdentifier(tableName)).execute();
+
+    std::vector<TableColumn> columns;
+    for (auto row : result)
+        columns.push_back({row[0].get<std::string>(), row[2].get<std::string>() == "YES"});
+
+    return columns;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../database/DatabaseManager.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CSVImporter
+{
+public:
+    struct Options
+    {
+        char delimiter = ',';
+        bool hasHeader = true;
+        size_t batchRows = 1000;
+    };
+
+    struct TableColumn
+    {
+        std::string name;
+        bool nullable = true;
+    };
+
+    struct ColumnMapping
+    {
+        size_t fileColumn;
+        std::string tableColumn;
+        bool nullable = true;
+    };
+
+    // Every window of the file commits on its own, a failed import keeps the rows committed before it
+    struct Report
+    {
+        size_t committedRows = 0;
+        std::string error;
+    };
+
+public:
+    static bool importFromCSV(DatabaseManager* dbManager, const std::string& filename, const std::string& tableName, Report& report);
+    static bool importFromCSV(DatabaseManager* dbManager, const std::string& filename, const std::string& tableName,
+                              const Options& options, Report& report);
+
+    static bool isDelimitedFile(const std::string& filename);
+    static Options detectOptions(const std::string& filename);
+    static std::vector<ColumnMapping> mapColumns(const std::vector<std::string>& header, const std::vector<TableColumn>& tableColumns,
+                                                 bool hasHeader);
+
+private:
+    struct Field
+    {
+        std::string_view text;
+        bool quoted = false;
+        bool hasEscapedQuotes = false;
+    };
+
+    struct Chunk
+    {
+        const char* begin;
+        const char* end;
+    };
+
+private:
+    static const char* parseRecord(const char* p, const char* end, char delimiter, std::vector<Field>& fields);
+    static const char* findSpecial(const char* p, const char* end, char delimiter);
+    static const char* skipRecord(const char* p, const char* end, char delimiter);
+    static std::vector<Chunk> splitIntoChunks(const char* begin, const char* end, size_t chunkCount, char delimiter, bool lastBlock,
+                                              const char*& recordsEnd);
+
+    static std::vector<std::string> buildInsertStatements(Chunk chunk, const Options& options, const std::string& insertPrefix,
+                                                          const std::vector<ColumnMapping>& mapping);
+    static void appendField(std::string& out, const Field& field, const ColumnMapping& column);
+    static void appendMissing(std::string& out, const ColumnMapping& column);
+
+    static std::vector<std::string> readHeader(std::string_view data, const Options& options);
+    static std::vector<TableColumn> getTableColumns(DatabaseManager* dbManager, const std::string& tableName);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+};
@@ -1,8 +1,9 @@
 #include "DatabaseExporter.h"
+#include "MappedFile.h"
+#include "../logging/Logger.h"
 
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 
 bool DatabaseExporter::exportToSQL(DatabaseManager* dbManager, TableManager* tableManager, const std::string& filename)
 {
@@ -15,7 +16,7 @@ bool DatabaseExporter::exportToSQL(DatabaseManager* dbManager, TableManager* tab
     }
     catch (const std::exception& e)
     {
-        std::cerr << "Export error: " << e.what() << std::endl;
+        LOG_ERROR("Export error: " << e.what());
         return false;
     }
 }
@@ -24,21 +25,15 @@ bool DatabaseExporter::importFromSQL(DatabaseManager* dbManager, const std::stri
 {
     try
     {
-        std::ifstream file(filename);
+        // Statements are slices of the mapping, so it has to outlive their execution
+        MappedFile file(filename);
 
-        if (!file.is_open())
-            throw std::runtime_error("Cannot open file: " + filename);
-
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string sql = buffer.str();
-
-        auto statements = SQLScriptParser::parseScript(sql);
+        auto statements = SQLScriptParser::parseScript(file.view());
         return executeStatements(dbManager, statements);
     }
     catch (const std::exception& e)
     {
-        std::cerr << "Import error: " << e.what() << std::endl;
+        LOG_ERROR("Import error: " << e.what());
         return false;
     }
 }
@@ -86,8 +81,8 @@ bool DatabaseExporter::executeStatements(DatabaseManager* dbManager, const std::
             if (stmt.type != SQLScriptParser::SQLStatement::Type::CREATE_TABLE &&
                 stmt.type != SQLScriptParser::SQLStatement::Type::INSERT)
             {
-                std::cout << "Executing: " << stmt.content << std::endl;
-                session.sql(stmt.content).execute();
+                LOG_DEBUG("Executing: " << stmt.content);
+                session.sql(std::string(stmt.content)).execute();
             }
         }
 
@@ -95,22 +90,22 @@ bool DatabaseExporter::executeStatements(DatabaseManager* dbManager, const std::
         {
             if (stmt.type == SQLScriptParser::SQLStatement::Type::CREATE_TABLE)
             {
-                std::cout << "Creating table: " << stmt.tableName << std::endl;
-                session.sql(stmt.content).execute();
+                LOG_DEBUG("Creating table: " << stmt.tableName);
+                session.sql(std::string(stmt.content)).execute();
             }
         }
 
         for (const auto& stmt : statements)
         {
             if (stmt.type == SQLScriptParser::SQLStatement::Type::INSERT)
-                session.sql(stmt.content).execute();
+                session.sql(std::string(stmt.content)).execute();
         }
 
         return true;
     }
     catch (const mysqlx::Error& e)
     {
-        std::cerr << "MySQL error during statement execution: " << e.what() << std::endl;
+        LOG_ERROR("MySQL error during statement execution: " << e.what());
         throw;
     }
 }
@@ -1,6 +1,6 @@
 #include "DatabaseStructureHandler.h"
 
-#include <iostream>
+#include "../logging/Logger.h"
 
 DatabaseStructureHandler::DatabaseStructureHandler(DatabaseManager* dbManager, TableManager* tableManager)
     : m_dbManager(dbManager)
@@ -22,7 +22,7 @@ std::vector<std::string> DatabaseStructureHandler::getOrderedTableNames()
 {
     if (m_dbManager->hasCircularDependencies())
     {
-        std::cerr << "Warning: Circular dependencies detected" << std::endl;
+        LOG_WARNING("Circular dependencies detected");
         return m_tableManager->getTableNames();
     }
     return m_tableManager->getOrderedTableNames();
@@ -0,0 +1,611 @@
+#include "DirectoryExporter.h"
+#include "MappedFile.h"
+#include "SQLScriptParser.h"
+
+#include "../database/SessionPool.h"
+#include "../database/TableChecksum.h"
+#include "../database/TableStructureManager.h"
+#include "../database/ValueFormatter.h"
+#include "../logging/Logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+bool DirectoryExporter::exportToDirectory(DatabaseManager* dbManager, const std::string& directory, const std::string& baseDirectory)
+{
+    mysqlx::Session* lockedSession = nullptr;
+
+    try
+    {
+        auto& session = dbManager->getSession();
+        std::string dbName = dbManager->getCurrentDatabase();
+
+        if (dbName.empty())
+            throw std::runtime_error("No database selected");
+
+        std::filesystem::create_directories(std::filesystem::path(directory) / "data");
+
+        // A manifest left by an earlier export would mark this one complete if it fails halfway
+        std::filesystem::remove(std::filesystem::path(directory) / ExportManifest::FILE_NAME);
+
+        // Writes are held off until every worker has opened its snapshot, the catalog is read under the same lock,
+        // so the schema, the change tracking and the data of all tables belong to one point in time
+        if (lockTables(session))
+            lockedSession = &session;
+
+        TableStructureManager structureManager(session);
+        auto dependencies = structureManager.buildDependencyGraph();
+        auto primaryKeys = getPrimaryKeys(session);
+
+        ExportManifest manifest;
+        manifest.database = dbName;
+        manifest.createdAt = static_cast<int64_t>(std::time(nullptr));
+
+        for (const auto& name : structureManager.getOrderedTableNames(dependencies))
+        {
+            ExportManifest::Table table;
+            table.name = name;
+            table.primaryKey = primaryKeys[name];
+            table.dependencies = dependencies[name];
+            manifest.tables.push_back(std::move(table));
+        }
+
+        std::string schema = "-- Database export\n";
+        schema += "-- Database: " + dbName + "\n\n";
+        schema += "SET FOREIGN_KEY_CHECKS=0;\n\n";
+        schema += "CREATE DATABASE IF NOT EXISTS " + ValueFormatter::quoteIdentifier(dbName) + ";\n";
+        schema += "USE " + ValueFormatter::quoteIdentifier(dbName) + ";\n\n";
+
+        for (const auto& table : manifest.tables)
+            schema += structureManager.getCreateStatement(table.name) + ";\n\n";
+
+        std::ofstream schemaFile(std::filesystem::path(directory) / manifest.schemaFile, std::ios::binary);
+        if (!schemaFile.write(schema.data(), schema.size()))
+            throw std::runtime_error("Cannot write " + manifest.schemaFile);
+        schemaFile.close();
+
+        manifest.schemaChecksum = ExportManifest::checksum(schema);
+
+        ExportManifest base;
+        std::string baseDir = baseDirectory.empty() ? "" : resolveDirectory(baseDirectory);
+
+        if (!baseDir.empty())
+        {
+            if (!ExportManifest::load((std::filesystem::path(baseDir) / ExportManifest::FILE_NAME).string(), base))
+                throw std::runtime_error("Cannot read the base export manifest in " + baseDir);
+            if (base.database != dbName)
+                throw std::runtime_error("Base export belongs to database " + base.database);
+            if (std::filesystem::equivalent(baseDir, directory))
+                throw std::runtime_error("Incremental export needs a directory different from its base");
+
+            manifest.baseExport = baseDir;
+        }
+
+        // Change tracking is sampled before any worker snapshot starts, so even without the lock a write racing
+        // the export can only make the next incremental run dump more, never less
+        auto columns = TableChecksum::getColumns(session);
+        auto updateTimes = getUpdateTimes(session);
+        manifest.serverTime = session.sql("SELECT CAST(NOW() AS CHAR)").execute().fetchOne()[0].get<std::string>();
+
+        std::vector<Plan> plans(manifest.tables.size(), Plan::FULL);
+        std::vector<const ExportManifest::Table*> previous(manifest.tables.size(), nullptr);
+        std::vector<size_t> exportJobs;
+
+        for (size_t i = 0; i < manifest.tables.size(); ++i)
+        {
+            auto& table = manifest.tables[i];
+            table.updateTime = updateTimes[table.name];
+            table.highWaterColumn = TableChecksum::findHighWaterColumn(columns[table.name]);
+
+            table.columnsChecksum = columnsChecksum(columns[table.name]);
+
+            // Older manifests lack the tracking and digests needed to carry chunks over
+            previous[i] = baseDir.empty() || base.version < ExportManifest::VERSION ? nullptr : base.findTable(table.name);
+            if (previous[i] && previous[i]->columnsChecksum != table.columnsChecksum)
+                previous[i] = nullptr;
+
+            const auto* prev = previous[i];
+
+            // UPDATE_TIME has one second resolution, it only proves nothing changed if it predates the base export
+            if (prev && !table.updateTime.empty() && table.updateTime == prev->updateTime && prev->updateTime < base.serverTime)
+                plans[i] = Plan::REUSE;
+            else if (prev && !table.highWaterColumn.empty() && table.highWaterColumn == prev->highWaterColumn &&
+                     !prev->highWaterMark.empty())
+                plans[i] = Plan::APPEND;
+
+            if (plans[i] != Plan::REUSE)
+                exportJobs.push_back(i);
+        }
+
+        auto unlock = [&]() {
+            unlockTables(*lockedSession);
+            lockedSession = nullptr;
+        };
+
+        // Tables are dumped concurrently, each worker reads its tables from its own snapshot
+        SessionPool::forEach(
+            dbManager, dbName, exportJobs.size(),
+            [&](mysqlx::Session& worker, size_t index) {
+                size_t tableIndex = exportJobs[index];
+                auto& table = manifest.tables[tableIndex];
+                const auto* prev = previous[tableIndex];
+
+                // Tables without a high water column are only carried over when their checksum did not change
+                if (plans[tableIndex] == Plan::FULL && table.highWaterColumn.empty())
+                {
+                    table.checksum = TableChecksum::checksumTable(worker, table.name);
+                    if (prev && table.checksum != 0 && table.checksum == prev->checksum)
+                    {
+                        reuseChunks(baseDir, directory, *prev, table);
+                        copyChangeTracking(*prev, table);
+                        return;
+                    }
+                }
+
+                std::vector<std::string> columnNames;
+                for (const auto& column : columns[table.name])
+                    columnNames.push_back(column.name);
+
+                std::string highWater = ValueFormatter::quoteIdentifier(table.highWaterColumn);
+                std::string mark;
+
+                if (plans[tableIndex] == Plan::APPEND)
+                    ValueFormatter::appendQuoted(mark, prev->highWaterMark);
+
+                // Rows up to the old mark must be untouched, otherwise updates or deletes happened and only a full dump is correct
+                if (plans[tableIndex] == Plan::APPEND &&
+                    TableChecksum::compute(worker, table.name, columnNames, highWater + " <= " + mark) ==
+                        TableChecksum::Digest{prev->prefixRows, prev->prefixHash})
+                {
+                    reuseChunks(baseDir, directory, *prev, table);
+                    exportTable(worker, directory, tableIndex, table, highWater + " > " + mark);
+
+                    // New rows only sort after the old chunks when the mark is the key itself, otherwise they fall inside
+                    // the old key ranges and the table is verified as a whole
+                    if (table.primaryKey.size() != 1 || table.highWaterColumn != table.primaryKey[0])
+                        dropKeyRanges(table);
+                }
+                else
+                {
+                    exportTable(worker, directory, tableIndex, table);
+                }
+
+                if (!table.highWaterColumn.empty())
+                    updateHighWater(worker, table, columnNames);
+
+                recordDigests(worker, table, columnNames);
+            },
+            [](mysqlx::Session& worker) { worker.sql("START TRANSACTION WITH CONSISTENT SNAPSHOT").execute(); },
+            lockedSession ? SessionPool::Ready(unlock) : SessionPool::Ready());
+
+        for (size_t i = 0; i < manifest.tables.size(); ++i)
+        {
+            if (plans[i] == Plan::REUSE)
+            {
+                reuseChunks(baseDir, directory, *previous[i], manifest.tables[i]);
+                copyChangeTracking(*previous[i], manifest.tables[i]);
+            }
+        }
+
+        // The manifest is written last, its presence marks the export as complete
+        if (!manifest.save((std::filesystem::path(directory) / ExportManifest::FILE_NAME).string()))
+            throw std::runtime_error("Cannot write manifest");
+
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        if (lockedSession)
+            unlockTables(*lockedSession);
+
+        LOG_ERROR("Directory export error: " << e.what());
+        return false;
+    }
+}
+
+bool DirectoryExporter::importFromDirectory(DatabaseManager* dbManager, const std::string& path,
+                                            const std::vector<std::string>& tables)
+{
+    try
+    {
+        std::string directory = resolveDirectory(path);
+
+        ExportManifest manifest;
+        if (!ExportManifest::load((std::filesystem::path(directory) / ExportManifest::FILE_NAME).string(), manifest))
+            throw std::runtime_error("Cannot read the export manifest in " + directory);
+
+        std::set<std::string> selected;
+        for (const auto& name : tables)
+        {
+            if (!manifest.findTable(name))
+                throw std::runtime_error("Table " + name + " is not part of the export");
+            selected.insert(name);
+        }
+
+        MappedFile schemaFile((std::filesystem::path(directory) / manifest.schemaFile).string());
+        if (ExportManifest::checksum(schemaFile.view()) != manifest.schemaChecksum)
+            throw std::runtime_error("Checksum mismatch in " + manifest.schemaFile);
+
+        auto& session = dbManager->getSession();
+
+        for (const auto& stmt : SQLScriptParser::parseScript(schemaFile.view()))
+        {
+            if (stmt.type != SQLScriptParser::SQLStatement::Type::CREATE_TABLE)
+            {
+                session.sql(std::string(stmt.content)).execute();
+                continue;
+            }
+
+            if (!selected.empty() && selected.find(stmt.tableName) == selected.end())
+                continue;
+
+            session.sql("DROP TABLE IF EXISTS " + ValueFormatter::quoteIdentifier(stmt.tableName)).execute();
+            session.sql(std::string(stmt.content)).execute();
+        }
+
+        session.sql("SET FOREIGN_KEY_CHECKS=1").execute();
+
+        std::vector<const ExportManifest::Chunk*> chunks;
+        for (const auto& table : manifest.tables)
+        {
+            if (!selected.empty() && selected.find(table.name) == selected.end())
+                continue;
+
+            for (const auto& chunk : table.chunks)
+                chunks.push_back(&chunk);
+        }
+
+        // Largest chunks first so the workers finish at roughly the same time
+        std::sort(chunks.begin(), chunks.end(), [](const auto* a, const auto* b) { return a->bytes > b->bytes; });
+
+        SessionPool::forEach(
+            dbManager, manifest.database, chunks.size(),
+            [&](mysqlx::Session& worker, size_t index) { importChunk(worker, directory, *chunks[index]); },
+            [](mysqlx::Session& worker) {
+                worker.sql("SET FOREIGN_KEY_CHECKS=0").execute();
+                worker.sql("SET UNIQUE_CHECKS=0").execute();
+            });
+
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Directory import error: " << e.what());
+        return false;
+    }
+}
+
+bool DirectoryExporter::isDirectoryExport(const std::string& path)
+{
+    return std::filesystem::exists(std::filesystem::path(resolveDirectory(path)) / ExportManifest::FILE_NAME);
+}
+
+std::string DirectoryExporter::resolveDirectory(const std::string& path)
+{
+    std::filesystem::path resolved(path);
+    if (resolved.filename() == ExportManifest::FILE_NAME)
+        return resolved.parent_path().string();
+    return resolved.string();
+}
+
+void DirectoryExporter::exportTable(mysqlx::Session& session, const std::string& directory, size_t tableIndex,
+                                    ExportManifest::Table& table, const std::string& whereClause)
+{
+    std::string query = "SELECT * FROM " + ValueFormatter::quoteIdentifier(table.name);
+    if (!whereClause.empty())
+        query += " WHERE " + whereClause;
+    for (size_t i = 0; i < table.primaryKey.size(); ++i)
+        query += (i == 0 ? " ORDER BY " : ", ") + ValueFormatter::quoteIdentifier(table.primaryKey[i]);
+
+    auto result = session.sql(query).execute();
+    size_t columnCount = result.getColumnCount();
+
+    size_t keyColumn = columnCount;
+    if (table.primaryKey.size() == 1)
+    {
+        for (size_t i = 0; i < columnCount; ++i)
+        {
+            if (std::string(result.getColumn(i).getColumnName()) == table.primaryKey[0])
+                keyColumn = i;
+        }
+    }
+
+    const std::string prefix = "INSERT INTO " + ValueFormatter::quoteIdentifier(table.name) + " VALUES ";
+
+    std::ofstream out;
+    ExportManifest::Chunk chunk;
+    std::string statement;
+    size_t statementRows = 0;
+    std::string lastKey;
+
+    auto flushStatement = [&]() {
+        if (statementRows == 0)
+            return;
+
+        statement += ";\n";
+        chunk.checksum = ExportManifest::checksum(statement, chunk.checksum);
+        chunk.bytes += statement.size();
+        out.write(statement.data(), statement.size());
+
+        statement.clear();
+        statementRows = 0;
+    };
+
+    auto closeChunk = [&]() {
+        flushStatement();
+        out.close();
+
+        if (!out)
+            throw std::runtime_error("Cannot write " + chunk.file);
+
+        chunk.lastKey = lastKey;
+        table.chunks.push_back(std::move(chunk));
+        chunk = ExportManifest::Chunk();
+    };
+
+    while (mysqlx::Row row = result.fetchOne())
+    {
+        if (!out.is_open())
+        {
+            chunk.file = chunkFileName(table.name, tableIndex, table.chunks.size());
+            chunk.firstRow = table.rows;
+            chunk.checksum = ExportManifest::CHECKSUM_SEED;
+
+            // An earlier export into this directory may have linked the file to its base, rewriting it in place
+            // would change the base export too
+            auto path = std::filesystem::path(directory) / chunk.file;
+            std::filesystem::remove(path);
+
+            out.open(path, std::ios::binary);
+            if (!out.is_open())
+                throw std::runtime_error("Cannot create " + chunk.file);
+        }
+
+        if (statementRows == 0)
+            statement += prefix;
+        else
+            statement += ',';
+
+        statement += '(';
+        for (size_t i = 0; i < columnCount; ++i)
+        {
+            if (i > 0)
+                statement += ", ";
+            ValueFormatter::appendLiteral(statement, row[i]);
+        }
+        statement += ')';
+
+        // Key ranges are only recorded for keys that compare the same way as text on the server
+        if (keyColumn < columnCount && table.rows == 0 && row[keyColumn].getType() != mysqlx::Value::Type::INT64 &&
+            row[keyColumn].getType() != mysqlx::Value::Type::UINT64 && row[keyColumn].getType() != mysqlx::Value::Type::STRING)
+            keyColumn = columnCount;
+
+        if (keyColumn < columnCount)
+        {
+            lastKey = ValueFormatter::format(row[keyColumn]);
+            if (chunk.rows == 0)
+                chunk.firstKey = lastKey;
+        }
+
+        statementRows++;
+        chunk.rows++;
+        table.rows++;
+
+        if (statementRows >= STATEMENT_ROWS || statement.size() >= STATEMENT_BYTES)
+            flushStatement();
+
+        if (chunk.rows >= CHUNK_ROWS || chunk.bytes >= CHUNK_BYTES)
+            closeChunk();
+    }
+
+    if (out.is_open())
+        closeChunk();
+}
+
+void DirectoryExporter::updateHighWater(mysqlx::Session& session, ExportManifest::Table& table,
+                                        const std::vector<std::string>& columns)
+{
+    std::string highWater = ValueFormatter::quoteIdentifier(table.highWaterColumn);
+
+    auto row = session.sql("SELECT CAST(MAX(" + highWater + ") AS CHAR) FROM " + ValueFormatter::quoteIdentifier(table.name))
+                   .execute()
+                   .fetchOne();
+
+    table.highWaterMark = row && !row[0].isNull() ? row[0].get<std::string>() : "";
+    table.prefixRows = 0;
+    table.prefixHash = 0;
+
+    if (table.highWaterMark.empty())
+        return;
+
+    std::string mark;
+    ValueFormatter::appendQuoted(mark, table.highWaterMark);
+
+    auto digest = TableChecksum::compute(session, table.name, columns, highWater + " <= " + mark);
+    table.prefixRows = digest.rows;
+    table.prefixHash = digest.hash;
+}
+
+void DirectoryExporter::recordDigests(mysqlx::Session& session, ExportManifest::Table& table, const std::vector<std::string>& columns)
+{
+    // Digests let DatabaseVerifier check a restore range by range without reading the data back
+    if (!table.hasKeyRanges())
+    {
+        table.rowHash = TableChecksum::compute(session, table.name, columns).hash;
+        return;
+    }
+
+    for (auto& chunk : table.chunks)
+    {
+        if (chunk.rowHash != 0)
+            continue;
+
+        std::string range = TableChecksum::keyRangeClause(table.primaryKey[0], chunk.firstKey, chunk.lastKey);
+        chunk.rowHash = TableChecksum::compute(session, table.name, columns, range).hash;
+    }
+}
+
+void DirectoryExporter::dropKeyRanges(ExportManifest::Table& table)
+{
+    for (auto& chunk : table.chunks)
+    {
+        chunk.firstKey.clear();
+        chunk.lastKey.clear();
+        chunk.rowHash = 0;
+    }
+}
+
+void DirectoryExporter::reuseChunks(const std::string& baseDirectory, const std::string& directory,
+                                    const ExportManifest::Table& previous, ExportManifest::Table& table)
+{
+    // Hard links keep every export self-contained without copying the data, copying is the fallback across filesystems
+    for (const auto& chunk : previous.chunks)
+    {
+        auto source = std::filesystem::path(baseDirectory) / chunk.file;
+        auto target = std::filesystem::path(directory) / chunk.file;
+
+        std::error_code error;
+        std::filesystem::remove(target, error);
+        std::filesystem::create_hard_link(source, target, error);
+
+        if (error)
+            std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing);
+
+        table.chunks.push_back(chunk);
+    }
+
+    table.rows = previous.rows;
+}
+
+void DirectoryExporter::copyChangeTracking(const ExportManifest::Table& previous, ExportManifest::Table& table)
+{
+    if (table.checksum == 0)
+        table.checksum = previous.checksum;
+
+    table.rowHash = previous.rowHash;
+
+    if (table.highWaterColumn == previous.highWaterColumn)
+    {
+        table.highWaterMark = previous.highWaterMark;
+        table.prefixRows = previous.prefixRows;
+        table.prefixHash = previous.prefixHash;
+    }
+}
+
+void DirectoryExporter::importChunk(mysqlx::Session& session, const std::string& directory, const ExportManifest::Chunk& chunk)
+{
+    MappedFile file((std::filesystem::path(directory) / chunk.file).string());
+
+    if (file.size() != chunk.bytes || ExportManifest::checksum(file.view()) != chunk.checksum)
+        throw std::runtime_error("Checksum mismatch in " + chunk.file);
+
+    auto statements = SQLScriptParser::parseScript(file.view());
+
+    session.startTransaction();
+    try
+    {
+        for (const auto& stmt : statements)
+            session.sql(std::string(stmt.content)).execute();
+        session.commit();
+    }
+    catch (...)
+    {
+        session.rollback();
+        throw;
+    }
+}
+
+std::map<std::string, std::vector<std::string>> DirectoryExporter::getPrimaryKeys(mysqlx::Session& session)
+{
+    std::map<std::string, std::vector<std::string>> primaryKeys;
+
+    auto result = session
+                      .sql("SELECT TABLE_NAME, COLUMN_NAME FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE "
+                           "WHERE TABLE_SCHEMA = DATABASE() "
+                           "AND CONSTRAINT_NAME = 'PRIMARY' "
+                           "ORDER BY TABLE_NAME, ORDINAL_POSITION")
+                      .execute();
+
+    for (const auto& row : result.fetchAll())
+        primaryKeys[row[0].get<std::string>()].push_back(row[1].get<std::string>());
+
+    return primaryKeys;
+}
+
+bool DirectoryExporter::lockTables(mysqlx::Session& session)
+{
+    try
+    {
+        session.sql("FLUSH TABLES WITH READ LOCK").execute();
+        return true;
+    }
+    catch (const mysqlx::Error& e)
+    {
+        // Needs the RELOAD privilege, without it the tables are each consistent but not with one another
+        LOG_WARNING("Exporting without a global read lock, tables may come from different points in time: " << e.what());
+        return false;
+    }
+}
+
+void DirectoryExporter::unlockTables(mysqlx::Session& session)
+{
+    try
+    {
+        session.sql("UNLOCK TABLES").execute();
+    }
+    catch (const mysqlx::Error& e)
+    {
+        LOG_ERROR("Cannot release the export lock: " << e.what());
+    }
+}
+
+std::map<std::string, std::string> DirectoryExporter::getUpdateTimes(mysqlx::Session& session)
+{
+    std::map<std::string, std::string> updateTimes;
+
+    // MySQL 8 caches table statistics for a day by default, a stale UPDATE_TIME would hide changes
+    try
+    {
+        session.sql("SET SESSION information_schema_stats_expiry = 0").execute();
+    }
+    catch (const mysqlx::Error&)
+    {
+        // Older servers have no statistics cache
+    }
+
+    auto result = session
+                      .sql("SELECT TABLE_NAME, CAST(UPDATE_TIME AS CHAR) FROM INFORMATION_SCHEMA.TABLES "
+                           "WHERE TABLE_SCHEMA = DATABASE() "
+                           "AND TABLE_TYPE = 'BASE TABLE'")
+                      .execute();
+
+    for (const auto& row : result.fetchAll())
+        updateTimes[row[0].get<std::string>()] = row[1].isNull() ? "" : row[1].get<std::string>();
+
+    return updateTimes;
+}
+
+std::string DirectoryExporter::chunkFileName(const std::string& tableName, size_t tableIndex, size_t chunkIndex)
+{
+    std::string safeName;
+    for (char c : tableName)
+        safeName += (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-') ? c : '_';
+
+    // Names that had to be rewritten get the table position so they can't collide
+    if (safeName != tableName)
+        safeName += "-" + std::to_string(tableIndex);
+
+    return "data/" + safeName + "." + std::to_string(chunkIndex) + ".sql";
+}
+
+uint64_t DirectoryExporter::columnsChecksum(const std::vector<TableChecksum::ColumnInfo>& columns)
+{
+    uint64_t checksum = ExportManifest::CHECKSUM_SEED;
+    for (const auto& column : columns)
+        checksum = ExportManifest::checksum(column.name + " " + column.dataType + ";", checksum);
+    return checksum;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../database/DatabaseManager.h"
+#include "../database/TableChecksum.h"
+#include "ExportManifest.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Directory export layout:
+//   manifest.json           row counts, checksums, chunk boundaries and dependency order
+//   schema.sql              database and table definitions
+//   data/<table>.<n>.sql    multi-row INSERT chunks, each restorable on its own
+class DirectoryExporter
+{
+public:
+    // With a base export only changed tables are dumped, unchanged chunks are linked from the base
+    static bool exportToDirectory(DatabaseManager* dbManager, const std::string& directory, const std::string& baseDirectory = "");
+
+    // Restores every table, or only the listed ones (dropping and recreating them)
+    static bool importFromDirectory(DatabaseManager* dbManager, const std::string& path, const std::vector<std::string>& tables = {});
+
+    static bool isDirectoryExport(const std::string& path);
+    static std::string resolveDirectory(const std::string& path);
+    static uint64_t columnsChecksum(const std::vector<TableChecksum::ColumnInfo>& columns);
+
+private:
+    enum class Plan
+    {
+        FULL,
+        REUSE,
+        APPEND
+    };
+
+    static void exportTable(mysqlx::Session& session, const std::string& directory, size_t tableIndex, ExportManifest::Table& table,
+                            const std::string& whereClause = "");
+    static void updateHighWater(mysqlx::Session& session, ExportManifest::Table& table, const std::vector<std::string>& columns);
+    static void reuseChunks(const std::string& baseDirectory, const std::string& directory, const ExportManifest::Table& previous,
+                            ExportManifest::Table& table);
+    static void dropKeyRanges(ExportManifest::Table& table);
+    static void recordDigests(mysqlx::Session& session, ExportManifest::Table& table, const std::vector<std::string>& columns);
+    static void copyChangeTracking(const ExportManifest::Table& previous, ExportManifest::Table& table);
+    static void importChunk(mysqlx::Session& session, const std::string& directory, const ExportManifest::Chunk& chunk);
+
+    static bool lockTables(mysqlx::Session& session);
+    static void unlockTables(mysqlx::Session& session);
+    static std::map<std::string, std::vector<std::string>> getPrimaryKeys(mysqlx::Session& session);
+    static std::map<std::string, std::string> getUpdateTimes(mysqlx::Session& session);
+    static std::string chunkFileName(const std::string& tableName, size_t tableIndex, size_t chunkIndex);
+
+private:
+    static constexpr uint64_t CHUNK_ROWS = 100000;
+    static constexpr uint64_t CHUNK_BYTES = 64 * 1024 * 1024;
+    static constexpr size_t STATEMENT_ROWS = 1000;
+    static constexpr size_t STATEMENT_BYTES = 1024 * 1024;
+};
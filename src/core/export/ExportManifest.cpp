@@ -0,0 +1,438 @@
+#include "ExportManifest.h"
+
+#include "../logging/Logger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+// Just enough JSON for the manifest: objects, arrays, strings, integers, booleans and null
+struct JsonValue
+{
+    enum class Type
+    {
+        NUL,
+        BOOL,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    Type type = Type::NUL;
+    bool boolean = false;
+    int64_t number = 0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::map<std::string, JsonValue> members;
+
+    const JsonValue& operator[](const std::string& key) const
+    {
+        static const JsonValue null;
+        auto it = members.find(key);
+        return it != members.end() ? it->second : null;
+    }
+
+    std::string asString() const { return type == Type::STRING ? text : ""; }
+    int64_t asNumber() const { return type == Type::NUMBER ? number : 0; }
+
+    std::vector<std::string> asStringList() const
+    {
+        std::vector<std::string> list;
+        for (const auto& item : items)
+            list.push_back(item.asString());
+        return list;
+    }
+};
+
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string_view input)
+        : input(input)
+    {
+    }
+
+    JsonValue parse()
+    {
+        JsonValue value = parseValue();
+        skipWhitespace();
+        if (pos != input.size())
+            fail("Unexpected trailing data");
+        return value;
+    }
+
+private:
+    JsonValue parseValue()
+    {
+        skipWhitespace();
+        if (pos >= input.size())
+            fail("Unexpected end of input");
+
+        JsonValue value;
+        char c = input[pos];
+
+        if (c == '{')
+        {
+            value.type = JsonValue::Type::OBJECT;
+            pos++;
+            skipWhitespace();
+            if (consume('}'))
+                return value;
+
+            do
+            {
+                skipWhitespace();
+                std::string key = parseString();
+                skipWhitespace();
+                expect(':');
+                value.members[key] = parseValue();
+                skipWhitespace();
+            } while (consume(','));
+            expect('}');
+        }
+        else if (c == '[')
+        {
+            value.type = JsonValue::Type::ARRAY;
+            pos++;
+            skipWhitespace();
+            if (consume(']'))
+                return value;
+
+            do
+            {
+                value.items.push_back(parseValue());
+                skipWhitespace();
+            } while (consume(','));
+            expect(']');
+        }
+        else if (c == '"')
+        {
+            value.type = JsonValue::Type::STRING;
+            value.text = parseString();
+        }
+        else if (c == '-' || (c >= '0' && c <= '9'))
+        {
+            value.type = JsonValue::Type::NUMBER;
+            size_t start = pos++;
+            while (pos < input.size() && input[pos] >= '0' && input[pos] <= '9')
+                pos++;
+            value.number = std::stoll(std::string(input.substr(start, pos - start)));
+        }
+        else if (input.compare(pos, 4, "true") == 0 || input.compare(pos, 5, "false") == 0)
+        {
+            value.type = JsonValue::Type::BOOL;
+            value.boolean = input[pos] == 't';
+            pos += value.boolean ? 4 : 5;
+        }
+        else if (input.compare(pos, 4, "null") == 0)
+        {
+            pos += 4;
+        }
+        else
+        {
+            fail("Unexpected character");
+        }
+
+        return value;
+    }
+
+    std::string parseString()
+    {
+        expect('"');
+        std::string result;
+
+        while (pos < input.size() && input[pos] != '"')
+        {
+            char c = input[pos++];
+            if (c != '\\')
+            {
+                result += c;
+                continue;
+            }
+
+            if (pos >= input.size())
+                break;
+
+            char escaped = input[pos++];
+            switch (escaped)
+            {
+            case 'n':
+                result += '\n';
+                break;
+            case 't':
+                result += '\t';
+                break;
+            case 'r':
+                result += '\r';
+                break;
+            case 'b':
+                result += '\b';
+                break;
+            case 'f':
+                result += '\f';
+                break;
+            case 'u':
+            {
+                if (pos + 4 > input.size())
+                    fail("Truncated escape");
+                unsigned code = std::stoul(std::string(input.substr(pos, 4)), nullptr, 16);
+                pos += 4;
+                // The writer only escapes control characters, so a single byte is enough here
+                result += static_cast<char>(code);
+                break;
+            }
+            default:
+                result += escaped;
+                break;
+            }
+        }
+
+        expect('"');
+        return result;
+    }
+
+    void skipWhitespace()
+    {
+        while (pos < input.size() && (input[pos] == ' ' || input[pos] == '\n' || input[pos] == '\r' || input[pos] == '\t'))
+            pos++;
+    }
+
+    bool consume(char c)
+    {
+        if (pos < input.size() && input[pos] == c)
+        {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c))
+            fail(std::string("Expected '") + c + "'");
+    }
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        throw std::runtime_error("Invalid manifest: " + message + " at offset " + std::to_string(pos));
+    }
+
+private:
+    std::string_view input;
+    size_t pos = 0;
+};
+
+std::string quote(const std::string& text)
+{
+    std::string result = "\"";
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\r':
+            result += "\\r";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                result += buffer;
+            }
+            else
+            {
+                result += c;
+            }
+        }
+    }
+    return result + "\"";
+}
+
+std::string quoteList(const std::vector<std::string>& list)
+{
+    std::string result = "[";
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        if (i > 0)
+            result += ", ";
+        result += quote(list[i]);
+    }
+    return result + "]";
+}
+} // namespace
+
+bool ExportManifest::save(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Cannot write manifest: " << filename);
+        return false;
+    }
+
+    file << "{\n";
+    file << "  \"version\": " << version << ",\n";
+    file << "  \"database\": " << quote(database) << ",\n";
+    file << "  \"createdAt\": " << createdAt << ",\n";
+    file << "  \"serverTime\": " << quote(serverTime) << ",\n";
+    file << "  \"baseExport\": " << quote(baseExport) << ",\n";
+    file << "  \"schema\": {\"file\": " << quote(schemaFile) << ", \"checksum\": " << quote(toHex(schemaChecksum)) << "},\n";
+    file << "  \"tables\": [";
+
+    for (size_t t = 0; t < tables.size(); ++t)
+    {
+        const auto& table = tables[t];
+
+        file << (t > 0 ? ",\n" : "\n");
+        file << "    {\n";
+        file << "      \"name\": " << quote(table.name) << ",\n";
+        file << "      \"rows\": " << table.rows << ",\n";
+        file << "      \"primaryKey\": " << quoteList(table.primaryKey) << ",\n";
+        file << "      \"dependencies\": " << quoteList(table.dependencies) << ",\n";
+        file << "      \"updateTime\": " << quote(table.updateTime) << ",\n";
+        file << "      \"checksum\": " << quote(toHex(table.checksum)) << ",\n";
+        file << "      \"columnsChecksum\": " << quote(toHex(table.columnsChecksum)) << ",\n";
+        file << "      \"rowHash\": " << quote(toHex(table.rowHash)) << ",\n";
+        file << "      \"highWater\": {\"column\": " << quote(table.highWaterColumn) << ", \"mark\": " << quote(table.highWaterMark)
+             << ", \"rows\": " << table.prefixRows << ", \"hash\": " << quote(toHex(table.prefixHash)) << "},\n";
+        file << "      \"chunks\": [";
+
+        for (size_t c = 0; c < table.chunks.size(); ++c)
+        {
+            const auto& chunk = table.chunks[c];
+
+            file << (c > 0 ? ",\n" : "\n");
+            file << "        {\"file\": " << quote(chunk.file) << ", \"firstRow\": " << chunk.firstRow << ", \"rows\": " << chunk.rows
+                 << ", \"bytes\": " << chunk.bytes << ", \"checksum\": " << quote(toHex(chunk.checksum))
+                 << ", \"firstKey\": " << quote(chunk.firstKey) << ", \"lastKey\": " << quote(chunk.lastKey)
+                 << ", \"rowHash\": " << quote(toHex(chunk.rowHash)) << "}";
+        }
+
+        file << (table.chunks.empty() ? "]\n" : "\n      ]\n");
+        file << "    }";
+    }
+
+    file << (tables.empty() ? "]\n" : "\n  ]\n");
+    file << "}\n";
+
+    return file.good();
+}
+
+bool ExportManifest::load(const std::string& filename, ExportManifest& manifest)
+{
+    try
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open manifest: " + filename);
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string content = buffer.str();
+
+        JsonValue root = JsonParser(content).parse();
+
+        manifest = ExportManifest();
+        manifest.version = static_cast<int>(root["version"].asNumber());
+        if (manifest.version < 1 || manifest.version > VERSION)
+            throw std::runtime_error("Unsupported manifest version " + std::to_string(manifest.version));
+
+        manifest.database = root["database"].asString();
+        manifest.createdAt = root["createdAt"].asNumber();
+        manifest.serverTime = root["serverTime"].asString();
+        manifest.baseExport = root["baseExport"].asString();
+        manifest.schemaFile = root["schema"]["file"].asString();
+        manifest.schemaChecksum = fromHex(root["schema"]["checksum"].asString());
+
+        for (const auto& tableValue : root["tables"].items)
+        {
+            Table table;
+            table.name = tableValue["name"].asString();
+            table.rows = static_cast<uint64_t>(tableValue["rows"].asNumber());
+            table.primaryKey = tableValue["primaryKey"].asStringList();
+            table.dependencies = tableValue["dependencies"].asStringList();
+            table.updateTime = tableValue["updateTime"].asString();
+            table.checksum = fromHex(tableValue["checksum"].asString());
+            table.columnsChecksum = fromHex(tableValue["columnsChecksum"].asString());
+            table.rowHash = fromHex(tableValue["rowHash"].asString());
+            table.highWaterColumn = tableValue["highWater"]["column"].asString();
+            table.highWaterMark = tableValue["highWater"]["mark"].asString();
+            table.prefixRows = static_cast<uint64_t>(tableValue["highWater"]["rows"].asNumber());
+            table.prefixHash = fromHex(tableValue["highWater"]["hash"].asString());
+
+            for (const auto& chunkValue : tableValue["chunks"].items)
+            {
+                Chunk chunk;
+                chunk.file = chunkValue["file"].asString();
+                chunk.firstRow = static_cast<uint64_t>(chunkValue["firstRow"].asNumber());
+                chunk.rows = static_cast<uint64_t>(chunkValue["rows"].asNumber());
+                chunk.bytes = static_cast<uint64_t>(chunkValue["bytes"].asNumber());
+                chunk.checksum = fromHex(chunkValue["checksum"].asString());
+                chunk.firstKey = chunkValue["firstKey"].asString();
+                chunk.lastKey = chunkValue["lastKey"].asString();
+                chunk.rowHash = fromHex(chunkValue["rowHash"].asString());
+                table.chunks.push_back(std::move(chunk));
+            }
+
+            manifest.tables.push_back(std::move(table));
+        }
+
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Manifest error: " << e.what());
+        return false;
+    }
+}
+
+const ExportManifest::Table* ExportManifest::findTable(const std::string& name) const
+{
+    for (const auto& table : tables)
+    {
+        if (table.name == name)
+            return &table;
+    }
+    return nullptr;
+}
+
+uint64_t ExportManifest::checksum(std::string_view data, uint64_t hash)
+{
+    // FNV-1a, chainable by passing the previous result as the seed
+    for (unsigned char c : data)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string ExportManifest::toHex(uint64_t value)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+uint64_t ExportManifest::fromHex(const std::string& text)
+{
+    return text.empty() ? 0 : std::stoull(text, nullptr, 16);
+}
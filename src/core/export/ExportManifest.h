@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ExportManifest
+{
+public:
+    struct Chunk
+    {
+        std::string file; // Relative to the export directory
+        uint64_t firstRow = 0;
+        uint64_t rows = 0;
+        uint64_t bytes = 0;
+        uint64_t checksum = 0;
+        std::string firstKey; // Primary key boundaries, only for single column keys
+        std::string lastKey;
+        uint64_t rowHash = 0; // Server-side digest of the key range, see TableChecksum
+    };
+
+    struct Table
+    {
+        std::string name;
+        uint64_t rows = 0;
+        std::vector<std::string> primaryKey;
+        std::vector<std::string> dependencies;
+        std::vector<Chunk> chunks;
+
+        // Change tracking for incremental exports
+        std::string updateTime;
+        uint64_t columnsChecksum = 0; // Column names and types, data is only reused while they match
+        uint64_t checksum = 0; // CHECKSUM TABLE, only for tables without a high-water column
+        std::string highWaterColumn;
+        std::string highWaterMark;
+        uint64_t prefixRows = 0; // Row count and hash of everything up to the mark
+        uint64_t prefixHash = 0;
+
+        uint64_t rowHash = 0; // Whole table digest, for tables without single column key ranges
+
+        bool hasKeyRanges() const
+        {
+            if (primaryKey.size() != 1 || chunks.empty())
+                return false;
+
+            for (const auto& chunk : chunks)
+            {
+                if (chunk.firstKey.empty() || chunk.lastKey.empty())
+                    return false;
+            }
+            return true;
+        }
+    };
+
+public:
+    bool save(const std::string& filename) const;
+    static bool load(const std::string& filename, ExportManifest& manifest);
+
+    const Table* findTable(const std::string& name) const;
+
+    static uint64_t checksum(std::string_view data, uint64_t hash = CHECKSUM_SEED);
+    static std::string toHex(uint64_t value);
+    static uint64_t fromHex(const std::string& text);
+
+public:
+    static constexpr int VERSION = 3;
+    static constexpr uint64_t CHECKSUM_SEED = 14695981039346656037ULL;
+    static constexpr const char* FILE_NAME = "manifest.json";
+
+    int version = VERSION;
+    std::string database;
+    int64_t createdAt = 0;
+    std::string serverTime; // Server clock when change tracking was sampled
+    std::string baseExport; // Previous export the unchanged chunks were taken from
+    std::string schemaFile = "schema.sql";
+    uint64_t schemaChecksum = 0;
+    std::vector<Table> tables; // Dependency order, referenced tables first
+};
@@ -0,0 +1,100 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        m_file = nullptr;
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize))
+    {
+        CloseHandle(m_file);
+        throw std::runtime_error("Cannot read size of file: " + filename);
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    if (m_size == 0)
+        return;
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping)
+        m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (!m_data)
+    {
+        if (m_mapping)
+            CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        throw std::runtime_error("Cannot map file: " + filename);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file)
+        CloseHandle(m_file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    m_fd = open(filename.c_str(), O_RDONLY);
+    if (m_fd < 0)
+        throw std::runtime_error("Cannot open file: " + filename);
+
+    struct stat fileStat;
+    if (fstat(m_fd, &fileStat) != 0)
+    {
+        close(m_fd);
+        throw std::runtime_error("Cannot read size of file: " + filename);
+    }
+
+    m_size = static_cast<size_t>(fileStat.st_size);
+    if (m_size == 0)
+        return;
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        close(m_fd);
+        throw std::runtime_error("Cannot map file: " + filename);
+    }
+
+    // Imports read front to back, let the kernel read ahead aggressively and drop pages behind us
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+        munmap(const_cast<char*>(m_data), m_size);
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+#endif
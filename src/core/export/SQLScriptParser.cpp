@@ -1,15 +1,53 @@
 #include "SQLScriptParser.h"
 
 #include <algorithm>
+#include <cctype>
 
-std::vector<SQLScriptParser::SQLStatement> SQLScriptParser::parseScript(const std::string& sqlContent)
+namespace
+{
+bool equalsNoCase(std::string_view text, std::string_view keyword)
+{
+    if (text.size() != keyword.size())
+        return false;
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (std::toupper(static_cast<unsigned char>(text[i])) != keyword[i])
+            return false;
+    }
+    return true;
+}
+
+bool startsWithNoCase(std::string_view text, std::string_view keyword)
+{
+    return text.size() >= keyword.size() && equalsNoCase(text.substr(0, keyword.size()), keyword);
+}
+
+size_t findNoCase(std::string_view text, std::string_view keyword)
+{
+    if (text.size() < keyword.size())
+        return std::string_view::npos;
+
+    for (size_t i = 0; i + keyword.size() <= text.size(); i++)
+    {
+        if (equalsNoCase(text.substr(i, keyword.size()), keyword))
+            return i;
+    }
+    return std::string_view::npos;
+}
+} // namespace
+
+std::vector<SQLScriptParser::SQLStatement> SQLScriptParser::parseScript(std::string_view sqlContent)
 {
     std::vector<SQLStatement> statements;
     auto rawStatements = splitStatements(sqlContent);
 
-    for (const auto& stmt : rawStatements)
+    statements.reserve(rawStatements.size());
+
+    for (auto stmt : rawStatements)
     {
-        if (stmt.empty() || stmt.find_first_not_of(" \t\n\r") == std::string::npos)
+        stmt = trimLeading(stmt);
+        if (stmt.empty() || stmt == ";")
             continue;
 
         SQLStatement statement;
@@ -19,79 +57,114 @@ std::vector<SQLScriptParser::SQLStatement> SQLScriptParser::parseScript(const st
         if (statement.type == SQLStatement::Type::CREATE_TABLE || statement.type == SQLStatement::Type::INSERT)
             statement.tableName = extractTableName(stmt);
 
-        statements.push_back(statement);
+        statements.push_back(std::move(statement));
     }
 
     return statements;
 }
 
-SQLScriptParser::SQLStatement::Type SQLScriptParser::determineStatementType(const std::string& stmt)
+std::string_view SQLScriptParser::trimLeading(std::string_view stmt)
 {
-    std::string upperStmt = stmt;
-    std::transform(upperStmt.begin(), upperStmt.end(), upperStmt.begin(), ::toupper);
+    size_t pos = 0;
 
-    if (upperStmt.find("SET ") == 0)
-        return SQLStatement::Type::SET;
+    while (pos < stmt.size())
+    {
+        if (std::isspace(static_cast<unsigned char>(stmt[pos])))
+        {
+            pos++;
+        }
+        else if (stmt.compare(pos, 2, "--") == 0)
+        {
+            size_t lineEnd = stmt.find('\n', pos);
+            pos = lineEnd == std::string_view::npos ? stmt.size() : lineEnd + 1;
+        }
+        else if (stmt.compare(pos, 2, "/*") == 0)
+        {
+            size_t commentEnd = stmt.find("*/", pos + 2);
+            pos = commentEnd == std::string_view::npos ? stmt.size() : commentEnd + 2;
+        }
+        else
+        {
+            break;
+        }
+    }
 
-    if (upperStmt.find("CREATE DATABASE") != std::string::npos)
-        return SQLStatement::Type::CREATE_DATABASE;
+    return stmt.substr(pos);
+}
 
-    if (upperStmt.find("USE ") == 0)
+std::string_view SQLScriptParser::statementHead(std::string_view stmt)
+{
+    // Keywords and the table name always come before the column list or the row data,
+    // so bulk INSERT bodies are never scanned during classification
+    constexpr size_t MAX_HEAD = 256;
+
+    size_t headEnd = stmt.find('(');
+    return stmt.substr(0, std::min(headEnd, MAX_HEAD));
+}
+
+SQLScriptParser::SQLStatement::Type SQLScriptParser::determineStatementType(std::string_view stmt)
+{
+    if (startsWithNoCase(stmt, "SET "))
+        return SQLStatement::Type::SET;
+
+    if (startsWithNoCase(stmt, "USE "))
         return SQLStatement::Type::USE;
 
-    if (upperStmt.find("CREATE TABLE") != std::string::npos)
+    std::string_view head = statementHead(stmt);
+
+    if (findNoCase(head, "CREATE DATABASE") != std::string_view::npos)
+        return SQLStatement::Type::CREATE_DATABASE;
+
+    if (findNoCase(head, "CREATE TABLE") != std::string_view::npos)
         return SQLStatement::Type::CREATE_TABLE;
 
-    if (upperStmt.find("INSERT INTO") != std::string::npos)
+    if (findNoCase(head, "INSERT INTO") != std::string_view::npos)
         return SQLStatement::Type::INSERT;
 
     return SQLStatement::Type::OTHER;
 }
 
-std::string SQLScriptParser::extractTableName(const std::string& stmt)
+std::string SQLScriptParser::extractTableName(std::string_view stmt)
 {
-    std::string upperStmt = stmt;
-    std::transform(upperStmt.begin(), upperStmt.end(), upperStmt.begin(), ::toupper);
-
-    std::string tableName;
+    std::string_view head = statementHead(stmt);
     size_t pos;
 
-    if ((pos = upperStmt.find("CREATE TABLE")) != std::string::npos)
+    if ((pos = findNoCase(head, "CREATE TABLE")) != std::string_view::npos)
         pos += 12;
-    else if ((pos = upperStmt.find("INSERT INTO")) != std::string::npos)
+    else if ((pos = findNoCase(head, "INSERT INTO")) != std::string_view::npos)
         pos += 11;
     else
         return "";
 
     // Skip whitespace
-    while (pos < stmt.length() && std::isspace(stmt[pos]))
+    while (pos < stmt.length() && std::isspace(static_cast<unsigned char>(stmt[pos])))
         pos++;
 
+    if (pos >= stmt.length())
+        return "";
+
     // Handle backtick quotes
     if (stmt[pos] == '`')
     {
         pos++; // Skip opening backtick
         size_t end = stmt.find('`', pos);
 
-        if (end != std::string::npos)
-            tableName = stmt.substr(pos, end - pos);
-    }
-    else
-    {
-        while (pos < stmt.length() && !std::isspace(stmt[pos]) && stmt[pos] != '(' && stmt[pos] != ';')
-        {
-            tableName += stmt[pos];
-            pos++;
-        }
+        if (end != std::string_view::npos)
+            return std::string(stmt.substr(pos, end - pos));
+        return "";
     }
 
-    return tableName;
+    size_t start = pos;
+    while (pos < stmt.length() && !std::isspace(static_cast<unsigned char>(stmt[pos])) && stmt[pos] != '(' && stmt[pos] != ';')
+        pos++;
+
+    return std::string(stmt.substr(start, pos - start));
 }
 
-std::vector<std::string> SQLScriptParser::splitStatements(const std::string& sql)
+std::vector<std::string_view> SQLScriptParser::splitStatements(std::string_view sql)
 {
-    std::vector<std::string> statements;
-    std::string currentStmt;
+    std::vector<std::string_view> statements;
+    size_t stmtStart = 0;
     bool inString = false;
     bool inComment = false;
     bool lineComment = false;
@@ -101,60 +174,56 @@ std::vector<std::string> SQLScriptParser::splitStatements(const std::string& sql
         char c = sql[i];
         char next = (i + 1 < sql.length()) ? sql[i + 1] : '\0';
 
-        // Handle comments
-        if (!inString)
+        if (inString)
         {
-            if (!inComment && !lineComment && c == '-' && next == '-')
-            {
-                lineComment = true;
-                i++;
-                continue;
-            }
-            if (!inComment && !lineComment && c == '/' && next == '*')
-            {
-                inComment = true;
-                i++;
-                continue;
-            }
-            if (inComment && c == '*' && next == '/')
-            {
-                inComment = false;
+            if (c == '\\')
                 i++;
-                continue;
-            }
-            if (lineComment && c == '\n')
-            {
-                lineComment = false;
-                continue;
-            }
+            else if (c == '\'')
+                inString = false;
+            continue;
         }
 
-        // Skip if in comment
-        if (inComment || lineComment)
+        // Comments stay inside the statement slice, the server skips them
+        if (lineComment)
+        {
+            if (c == '\n')
+                lineComment = false;
             continue;
-
-        // Handle strings
-        if (c == '\'' && (i == 0 || sql[i - 1] != '\\'))
-            inString = !inString;
-
-        // Handle statement termination
-        if (!inString && c == ';')
+        }
+        if (inComment)
         {
-            currentStmt += c;
-            if (!currentStmt.empty())
+            if (c == '*' && next == '/')
             {
-                statements.push_back(currentStmt);
-                currentStmt.clear();
+                inComment = false;
+                i++;
             }
             continue;
         }
 
-        currentStmt += c;
+        if (c == '-' && next == '-')
+        {
+            lineComment = true;
+            i++;
+        }
+        else if (c == '/' && next == '*')
+        {
+            inComment = true;
+            i++;
+        }
+        else if (c == '\'')
+        {
+            inString = true;
+        }
+        else if (c == ';')
+        {
+            statements.push_back(sql.substr(stmtStart, i + 1 - stmtStart));
+            stmtStart = i + 1;
+        }
     }
 
     // Add last statement if it doesn't end with semicolon
-    if (!currentStmt.empty())
-        statements.push_back(currentStmt);
+    if (stmtStart < sql.length())
+        statements.push_back(sql.substr(stmtStart));
 
     return statements;
 }
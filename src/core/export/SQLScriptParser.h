@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 
 class SQLScriptParser
@@ -18,14 +19,17 @@ public:
         };
 
         Type type;
-        std::string content;
-        std::string tableName; // For CREATE_TABLE and INSERT statements
+        std::string_view content; // Slice of the parsed script, valid while the script buffer is alive
+        std::string tableName;    // For CREATE_TABLE and INSERT statements
     };
 
-    static std::vector<SQLStatement> parseScript(const std::string& sqlContent);
+    static std::vector<SQLStatement> parseScript(std::string_view sqlContent);
 
 private:
-    static SQLStatement::Type determineStatementType(const std::string& stmt);
-    static std::string extractTableName(const std::string& stmt);
-    static std::vector<std::string> splitStatements(const std::string& sql);
+    static SQLStatement::Type determineStatementType(std::string_view stmt);
+    static std::string extractTableName(std::string_view stmt);
+    static std::vector<std::string_view> splitStatements(std::string_view sql);
+
+    static std::string_view trimLeading(std::string_view stmt);
+    static std::string_view statementHead(std::string_view stmt);
 };
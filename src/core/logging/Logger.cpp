@@ -0,0 +1,155 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+Logger& Logger::getInstance()
+{
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : ring(std::make_unique<Record[]>(CAPACITY))
+    , minLevel(BODYA_LOG_LEVEL)
+{
+    for (uint64_t i = 0; i < CAPACITY; ++i)
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+
+    if (const char* requested = std::getenv("BODYA_LOG"))
+    {
+        static const char* names[] = {"trace", "debug", "info", "warning", "error"};
+        for (int level = 0; level < 5; ++level)
+        {
+            if (std::strcmp(requested, names[level]) == 0)
+                minLevel = std::max(level, BODYA_LOG_LEVEL);
+        }
+    }
+
+    writer = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger()
+{
+    shutdown();
+}
+
+void Logger::write(Level level, std::string message)
+{
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    Record* record = nullptr;
+
+    for (;;)
+    {
+        record = &ring[pos & (CAPACITY - 1)];
+        uint64_t sequence = record->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+
+        if (diff == 0)
+        {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->level = level;
+    record->time = std::chrono::system_clock::now();
+    record->message = std::move(message);
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    wakeSignal.notify_one();
+}
+
+void Logger::shutdown()
+{
+    if (!running.exchange(false))
+        return;
+
+    wakeSignal.notify_one();
+    if (writer.joinable())
+        writer.join();
+}
+
+void Logger::run()
+{
+    while (running.load())
+    {
+        if (drain())
+            continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeSignal.wait_for(lock, IDLE_WAIT);
+    }
+
+    // Whatever was logged before shutdown still goes out
+    while (drain())
+    {
+    }
+}
+
+bool Logger::drain()
+{
+    bool wrote = false;
+
+    for (;;)
+    {
+        Record& record = ring[tail & (CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != tail + 1)
+            break;
+
+        std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(record.time.time_since_epoch()).count() % 1000;
+
+        char stamp[16];
+        std::strftime(stamp, sizeof(stamp), "%H:%M:%S", std::localtime(&seconds));
+
+        FILE* stream = record.level >= Level::Warning ? stderr : stdout;
+        std::fprintf(stream, "%s.%03d %-7s %s\n", stamp, static_cast<int>(millis), levelName(record.level), record.message.c_str());
+
+        record.message.clear();
+        record.sequence.store(tail + CAPACITY, std::memory_order_release);
+        tail++;
+        wrote = true;
+    }
+
+    if (uint64_t lost = dropped.exchange(0, std::memory_order_relaxed))
+        std::fprintf(stderr, "%llu log records dropped\n", static_cast<unsigned long long>(lost));
+
+    if (wrote)
+    {
+        std::fflush(stdout);
+        std::fflush(stderr);
+    }
+
+    return wrote;
+}
+
+const char* Logger::levelName(Level level)
+{
+    switch (level)
+    {
+    case Level::Trace:
+        return "TRACE";
+    case Level::Debug:
+        return "DEBUG";
+    case Level::Info:
+        return "INFO";
+    case Level::Warning:
+        return "WARNING";
+    case Level::Error:
+        return "ERROR";
+    }
+    return "";
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Lowest level compiled into the binary: 0 trace, 1 debug, 2 info, 3 warning, 4 error, 5 nothing.
+// Set from CMake through BODYA_LOG_LEVEL; statements below it expand to nothing. At runtime the
+// BODYA_LOG environment variable (trace, debug, info, warning, error) raises or lowers the threshold
+// within what was compiled in.
+#ifndef BODYA_LOG_LEVEL
+#define BODYA_LOG_LEVEL 2
+#endif
+
+// Log records go into a fixed-size lock-free ring and are written by a background thread, so a log
+// statement on the render thread costs one string format and never touches the terminal.
+class Logger
+{
+public:
+    enum class Level : int
+    {
+        Trace = 0,
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    static Logger& getInstance();
+
+    bool enabled(Level level) const { return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed); }
+    void setLevel(Level level) { minLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    // Never blocks, a record is dropped (and counted) when the writer has fallen a full ring behind
+    void write(Level level, std::string message);
+
+    // Writes out everything queued so far and stops the writer thread
+    void shutdown();
+
+private:
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    struct Record
+    {
+        std::atomic<uint64_t> sequence{0};
+        Level level = Level::Info;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    void run();
+    bool drain();
+    static const char* levelName(Level level);
+
+private:
+    std::unique_ptr<Record[]> ring;
+    alignas(64) std::atomic<uint64_t> head{0}; // Next slot a producer claims
+    alignas(64) uint64_t tail = 0;             // Next slot the writer reads, only touched by the writer thread
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<int> minLevel;
+
+    std::thread writer;
+    std::mutex wakeMutex;
+    std::condition_variable wakeSignal;
+    std::atomic<bool> running{true};
+
+    static constexpr uint64_t CAPACITY = 4096; // Power of two so slots are found by masking
+    static constexpr auto IDLE_WAIT = std::chrono::seconds(1); // Bounds the delay if a wakeup races the writer going to sleep
+};
+
+#define BODYA_LOG(level, expr)                                                                                                     \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        if (Logger::getInstance().enabled(level))                                                                                  \
+        {                                                                                                                          \
+            std::ostringstream logStream;                                                                                          \
+            logStream << expr;                                                                                                     \
+            Logger::getInstance().write(level, logStream.str());                                                                  \
+        }                                                                                                                          \
+    } while (0)
+
+#define BODYA_LOG_DISABLED(expr)                                                                                                   \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+
+#if BODYA_LOG_LEVEL <= 0
+#define LOG_TRACE(expr) BODYA_LOG(Logger::Level::Trace, expr)
+#else
+#define LOG_TRACE(expr) BODYA_LOG_DISABLED(expr)
+#endif
+
+#if BODYA_LOG_LEVEL <= 1
+#define LOG_DEBUG(expr) BODYA_LOG(Logger::Level::Debug, expr)
+#else
+#define LOG_DEBUG(expr) BODYA_LOG_DISABLED(expr)
+#endif
+
+#if BODYA_LOG_LEVEL <= 2
+#define LOG_INFO(expr) BODYA_LOG(Logger::Level::Info, expr)
+#else
+#define LOG_INFO(expr) BODYA_LOG_DISABLED(expr)
+#endif
+
+#if BODYA_LOG_LEVEL <= 3
+#define LOG_WARNING(expr) BODYA_LOG(Logger::Level::Warning, expr)
+#else
+#define LOG_WARNING(expr) BODYA_LOG_DISABLED(expr)
+#endif
+
+#if BODYA_LOG_LEVEL <= 4
+#define LOG_ERROR(expr) BODYA_LOG(Logger::Level::Error, expr)
+#else
+#define LOG_ERROR(expr) BODYA_LOG_DISABLED(expr)
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+// Fork-join helpers for the client-side result operations, built on std::async so no extra runtime is needed
+class Parallel
+{
+public:
+    // Number of slices worth using for the given amount of work, at least one
+    static size_t workerCount(size_t items, size_t minChunk)
+    {
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        return std::max<size_t>(1, std::min(hardware, items / std::max<size_t>(1, minChunk)));
+    }
+
+    // Runs fn(begin, end) over equal slices of [0, count) on separate threads
+    template <typename Function>
+    static void forEach(size_t count, size_t minChunk, Function fn)
+    {
+        size_t workers = workerCount(count, minChunk);
+        if (workers <= 1)
+        {
+            fn(size_t{0}, count);
+            return;
+        }
+
+        std::vector<std::future<void>> pending;
+        for (size_t w = 0; w < workers; ++w)
+            pending.push_back(std::async(std::launch::async, fn, count * w / workers, count * (w + 1) / workers));
+
+        for (auto& task : pending)
+            task.get();
+    }
+
+    // Sorts slices in parallel, then merges neighbouring slices pairwise until one run is left
+    template <typename T, typename Compare>
+    static void sort(std::vector<T>& items, size_t minChunk, Compare less)
+    {
+        size_t workers = workerCount(items.size(), minChunk);
+        if (workers <= 1)
+        {
+            std::sort(items.begin(), items.end(), less);
+            return;
+        }
+
+        std::vector<size_t> bounds;
+        for (size_t w = 0; w <= workers; ++w)
+            bounds.push_back(items.size() * w / workers);
+
+        std::vector<std::future<void>> pending;
+        for (size_t w = 0; w < workers; ++w)
+        {
+            pending.push_back(std::async(std::launch::async, [&items, &less, begin = bounds[w], end = bounds[w + 1]] {
+                std::sort(items.begin() + begin, items.begin() + end, less);
+            }));
+        }
+        for (auto& task : pending)
+            task.get();
+
+        while (bounds.size() > 2)
+        {
+            std::vector<size_t> merged;
+            pending.clear();
+
+            for (size_t i = 0; i + 2 < bounds.size(); i += 2)
+            {
+                pending.push_back(std::async(std::launch::async, [&items, &less, begin = bounds[i], mid = bounds[i + 1], end = bounds[i + 2]] {
+                    std::inplace_merge(items.begin() + begin, items.begin() + mid, items.begin() + end, less);
+                }));
+                merged.push_back(bounds[i]);
+            }
+            if (bounds.size() % 2 == 0)
+                merged.push_back(bounds[bounds.size() - 2]);
+            merged.push_back(bounds.back());
+
+            for (auto& task : pending)
+                task.get();
+            bounds = std::move(merged);
+        }
+    }
+};
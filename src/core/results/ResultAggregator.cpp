@@ -0,0 +1,209 @@
+#include "ResultAggregator.h"
+#include "Parallel.h"
+#include "../logging/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+std::string_view cellAt(const QueryResult& source, uint32_t row, int column)
+{
+    const auto& cells = source.rows[row];
+    return column >= 0 && static_cast<size_t>(column) < cells.size() ? std::string_view(cells[column]) : std::string_view();
+}
+
+bool isNull(std::string_view value)
+{
+    return value == "NULL";
+}
+
+// Parses the whole cell as a number, anything else (dates, text, trailing garbage) is not numeric
+bool parseNumber(std::string_view value, double& number)
+{
+    if (value.empty() || value.size() > 63)
+        return false;
+
+    char buffer[64];
+    value.copy(buffer, value.size());
+    buffer[value.size()] = '\0';
+
+    char* end = nullptr;
+    number = std::strtod(buffer, &end);
+    return end == buffer + value.size() && std::isfinite(number);
+}
+} // namespace
+
+void ResultAggregator::Accumulator::merge(const Accumulator& other)
+{
+    count += other.count;
+    numeric += other.numeric;
+    sum += other.sum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+uint32_t ResultAggregator::Dictionary::intern(std::string_view value)
+{
+    auto [it, inserted] = ids.try_emplace(value, static_cast<uint32_t>(values.size()));
+    if (inserted)
+        values.push_back(value);
+    return it->second;
+}
+
+QueryResult ResultAggregator::aggregate(const QueryResult& source, const std::vector<uint32_t>& rows, const Spec& spec)
+{
+    QueryResult output;
+    if (spec.groupColumn >= source.columns.size())
+        return output;
+
+    size_t slices = Parallel::workerCount(rows.size(), PARALLEL_THRESHOLD);
+    std::vector<Partial> partials(slices);
+
+    Parallel::forEach(slices, 1, [&](size_t first, size_t last) {
+        for (size_t s = first; s < last; ++s)
+            aggregateSlice(source, rows, spec, rows.size() * s / slices, rows.size() * (s + 1) / slices, partials[s]);
+    });
+
+    // Slices are merged in row order, so ids in the merged dictionaries still follow first appearance
+    Partial merged = std::move(partials[0]);
+    for (size_t s = 1; s < slices; ++s)
+    {
+        std::vector<uint32_t> groupMap, pivotMap;
+        for (auto value : partials[s].groups.values)
+            groupMap.push_back(merged.groups.intern(value));
+        for (auto value : partials[s].pivots.values)
+            pivotMap.push_back(merged.pivots.intern(value));
+
+        for (const auto& [key, cell] : partials[s].cells)
+        {
+            uint64_t mergedKey = static_cast<uint64_t>(groupMap[key >> 32]) << 32 | pivotMap[key & 0xFFFFFFFFu];
+            merged.cells[mergedKey].merge(cell);
+        }
+    }
+
+    std::string valueName = spec.valueColumn >= 0 && static_cast<size_t>(spec.valueColumn) < source.columns.size()
+                                ? source.columns[spec.valueColumn]
+                                : "*";
+    size_t pivotCount = spec.pivotColumn >= 0 ? merged.pivots.values.size() : 1;
+    if (pivotCount > MAX_PIVOT_COLUMNS)
+    {
+        LOG_WARNING("Pivot has " << pivotCount << " distinct values, showing the first " << MAX_PIVOT_COLUMNS);
+        pivotCount = MAX_PIVOT_COLUMNS;
+    }
+
+    output.columns.push_back(source.columns[spec.groupColumn]);
+    if (spec.pivotColumn >= 0)
+    {
+        for (size_t p = 0; p < pivotCount; ++p)
+            output.columns.emplace_back(merged.pivots.values[p]);
+    }
+    else
+    {
+        output.columns.push_back(std::string(functionName(spec.function)) + "(" + valueName + ")");
+    }
+
+    for (size_t g = 0; g < merged.groups.values.size(); ++g)
+    {
+        std::vector<std::string> row;
+        row.reserve(pivotCount + 1);
+        row.emplace_back(merged.groups.values[g]);
+
+        for (size_t p = 0; p < pivotCount; ++p)
+        {
+            auto it = merged.cells.find(static_cast<uint64_t>(g) << 32 | p);
+            row.push_back(formatCell(it != merged.cells.end() ? &it->second : nullptr, spec.function));
+        }
+        output.rows.push_back(std::move(row));
+    }
+
+    return output;
+}
+
+void ResultAggregator::aggregateSlice(const QueryResult& source, const std::vector<uint32_t>& rows, const Spec& spec,
+                                      size_t begin, size_t end, Partial& partial)
+{
+    bool countRows = spec.valueColumn < 0;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t row = rows[i];
+        uint32_t group = partial.groups.intern(cellAt(source, row, static_cast<int>(spec.groupColumn)));
+        uint32_t pivot = spec.pivotColumn >= 0 ? partial.pivots.intern(cellAt(source, row, spec.pivotColumn)) : 0;
+        Accumulator& cell = partial.cells[static_cast<uint64_t>(group) << 32 | pivot];
+
+        if (countRows)
+        {
+            cell.count++;
+            continue;
+        }
+
+        std::string_view value = cellAt(source, row, spec.valueColumn);
+        if (isNull(value))
+            continue;
+
+        cell.count++;
+        double number = 0.0;
+        if (parseNumber(value, number))
+        {
+            cell.numeric++;
+            cell.sum += number;
+            cell.min = std::min(cell.min, number);
+            cell.max = std::max(cell.max, number);
+        }
+    }
+}
+
+std::string ResultAggregator::formatCell(const Accumulator* cell, Function function)
+{
+    if (function == Function::COUNT)
+        return std::to_string(cell ? cell->count : 0);
+
+    if (!cell || cell->numeric == 0)
+        return "NULL";
+
+    switch (function)
+    {
+    case Function::SUM:
+        return formatNumber(cell->sum);
+    case Function::MIN:
+        return formatNumber(cell->min);
+    case Function::MAX:
+        return formatNumber(cell->max);
+    case Function::AVG:
+        return formatNumber(cell->sum / cell->numeric);
+    default:
+        return "NULL";
+    }
+}
+
+std::string ResultAggregator::formatNumber(double value)
+{
+    if (value == std::floor(value) && std::fabs(value) < 1e15)
+        return std::to_string(static_cast<long long>(value));
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+const char* ResultAggregator::functionName(Function function)
+{
+    switch (function)
+    {
+    case Function::COUNT:
+        return "COUNT";
+    case Function::SUM:
+        return "SUM";
+    case Function::MIN:
+        return "MIN";
+    case Function::MAX:
+        return "MAX";
+    case Function::AVG:
+        return "AVG";
+    default:
+        return "?";
+    }
+}
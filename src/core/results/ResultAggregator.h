@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../../models/QueryResult.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// GROUP BY and pivot over rows that are already loaded, so slicing a result never goes back to the server.
+// Each thread hash-aggregates its slice of rows into a partial table, the partials are merged at the end.
+class ResultAggregator
+{
+public:
+    enum class Function
+    {
+        COUNT,
+        SUM,
+        MIN,
+        MAX,
+        AVG
+    };
+
+    struct Spec
+    {
+        size_t groupColumn = 0;
+        int pivotColumn = -1; // Distinct values of this column become output columns, -1 for a plain GROUP BY
+        int valueColumn = -1; // Column fed to the function, -1 counts rows
+        Function function = Function::COUNT;
+    };
+
+public:
+    // One output row per distinct group value in order of first appearance among the given rows
+    static QueryResult aggregate(const QueryResult& source, const std::vector<uint32_t>& rows, const Spec& spec);
+
+    static const char* functionName(Function function);
+
+private:
+    struct Accumulator
+    {
+        uint64_t count = 0;   // Rows, or non-NULL values when there is a value column
+        uint64_t numeric = 0; // Values that parsed as numbers
+        double sum = 0.0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+
+        void merge(const Accumulator& other);
+    };
+
+    // Dense ids for distinct values, in order of first appearance
+    struct Dictionary
+    {
+        std::unordered_map<std::string_view, uint32_t> ids;
+        std::vector<std::string_view> values;
+
+        uint32_t intern(std::string_view value);
+    };
+
+    struct Partial
+    {
+        Dictionary groups;
+        Dictionary pivots;
+        std::unordered_map<uint64_t, Accumulator> cells; // Keyed by group id << 32 | pivot id
+    };
+
+private:
+    static void aggregateSlice(const QueryResult& source, const std::vector<uint32_t>& rows, const Spec& spec, size_t begin,
+                               size_t end, Partial& partial);
+    static std::string formatCell(const Accumulator* cell, Function function);
+    static std::string formatNumber(double value);
+
+private:
+    static constexpr size_t PARALLEL_THRESHOLD = 1 << 14;
+    static constexpr size_t MAX_PIVOT_COLUMNS = 256;
+};
@@ -0,0 +1,428 @@
+#include "ResultView.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string_view>
+
+namespace
+{
+const std::string& cellAt(const QueryResult& result, uint32_t row, size_t column)
+{
+    static const std::string empty;
+    const auto& cells = result.rows[row];
+    return column < cells.size() ? cells[column] : empty;
+}
+
+bool isNull(const std::string& value)
+{
+    return value == "NULL";
+}
+
+struct SortEntry
+{
+    uint64_t key;
+    uint32_t row;
+    uint32_t group; // 0 sorts before 1, used to put NULLs first or last
+};
+
+// Maps a double onto an unsigned integer with the same ordering
+uint64_t numericKey(double value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : bits | 0x8000000000000000ULL;
+}
+
+// First eight bytes in big-endian order, so comparing keys orders strings like memcmp does
+uint64_t prefixKey(const std::string& value, size_t offset = 0)
+{
+    uint64_t key = 0;
+    for (size_t i = offset; i < offset + 8; ++i)
+        key = (key << 8) | (i < value.size() ? static_cast<unsigned char>(value[i]) : 0);
+    return key;
+}
+} // namespace
+
+void ResultView::reset(const QueryResult& result)
+{
+    order.resize(result.rows.size());
+    std::iota(order.begin(), order.end(), 0u);
+
+    matches.clear();
+    sortKeys.clear();
+    sortNulls.clear();
+    sortColumn = -1;
+    sortOrder = SortOrder::NONE;
+    filterText.clear();
+    filterNeedle.clear();
+
+    applySelection();
+}
+
+void ResultView::sort(const QueryResult& result, size_t column, SortOrder newOrder)
+{
+    sortColumn = newOrder == SortOrder::NONE ? -1 : static_cast<int>(column);
+    sortOrder = newOrder;
+
+    order.resize(result.rows.size());
+    std::iota(order.begin(), order.end(), 0u);
+
+    sortKeys.clear();
+    sortNulls.clear();
+
+    if (newOrder == SortOrder::NONE || column >= result.columns.size())
+    {
+        applySelection();
+        return;
+    }
+
+    size_t rowCount = result.rows.size();
+    bool descending = newOrder == SortOrder::DESCENDING;
+
+    sortHasText = false;
+    sortHasValues = false;
+    scanColumn(result, column, 0, rowCount);
+    bool numeric = isNumericSort();
+
+    // Rows are sorted as compact (group, key, row) entries so comparisons stay in cache instead of chasing
+    // strings. NULL sorts first ascending and last descending, the same as MySQL; ties keep the server order.
+    std::vector<SortEntry> entries(rowCount);
+    computeSortKeys(result, 0, rowCount);
+    for (size_t row = 0; row < rowCount; ++row)
+    {
+        uint64_t key = sortKeys[row];
+        bool null = sortNulls[row] != 0;
+        entries[row] = SortEntry{descending ? ~key : key, static_cast<uint32_t>(row), null != descending ? 0u : 1u};
+    }
+
+    Parallel::sort(entries, PARALLEL_THRESHOLD, [](const SortEntry& a, const SortEntry& b) {
+        if (a.group != b.group)
+            return a.group < b.group;
+        if (a.key != b.key)
+            return a.key < b.key;
+        return a.row < b.row;
+    });
+
+    // Text keys only hold eight bytes at a time. Runs that share them are re-keyed from the next eight bytes
+    // and sorted again, so strings are never compared directly.
+    if (!numeric)
+    {
+        struct Run
+        {
+            size_t begin;
+            size_t end;
+            size_t offset;
+        };
+
+        std::vector<Run> runs;
+        auto collectRuns = [&](size_t begin, size_t end, size_t offset) {
+            for (size_t first = begin; first < end;)
+            {
+                size_t last = first + 1;
+                while (last < end && entries[last].group == entries[first].group && entries[last].key == entries[first].key)
+                    last++;
+
+                if (last - first > 1 && entries[first].group == (descending ? 0u : 1u))
+                    runs.push_back(Run{first, last, offset});
+                first = last;
+            }
+        };
+
+        collectRuns(0, rowCount, 8);
+        while (!runs.empty())
+        {
+            Run run = runs.back();
+            runs.pop_back();
+
+            bool longer = false;
+            for (size_t i = run.begin; i < run.end; ++i)
+            {
+                const std::string& value = cellAt(result, entries[i].row, column);
+                uint64_t key = value.size() > run.offset ? prefixKey(value, run.offset) : 0;
+                entries[i].key = descending ? ~key : key;
+                longer = longer || value.size() > run.offset + 8;
+            }
+
+            std::sort(entries.begin() + run.begin, entries.begin() + run.end, [](const SortEntry& a, const SortEntry& b) {
+                return a.key != b.key ? a.key < b.key : a.row < b.row;
+            });
+
+            if (longer)
+                collectRuns(run.begin, run.end, run.offset + 8);
+        }
+    }
+
+    for (size_t i = 0; i < rowCount; ++i)
+        order[i] = entries[i].row;
+
+    applySelection();
+}
+
+void ResultView::filter(const QueryResult& result, const std::string& text)
+{
+    filterText = text;
+    filterNeedle = text;
+    std::transform(filterNeedle.begin(), filterNeedle.end(), filterNeedle.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    matches.assign(filterNeedle.empty() ? 0 : result.rows.size(), 0);
+    matchRows(result, 0, matches.size());
+
+    applySelection();
+}
+
+void ResultView::append(const QueryResult& result)
+{
+    size_t previous = order.size();
+    if (result.rows.size() <= previous)
+        return;
+
+    if (!filterNeedle.empty())
+    {
+        matches.resize(result.rows.size(), 0);
+        matchRows(result, previous, matches.size());
+    }
+
+    // New rows can land anywhere in a sorted order, in server order they only go after the existing ones
+    if (sortColumn >= 0)
+    {
+        appendSorted(result, previous);
+        return;
+    }
+
+    appendBase = version;
+    appendStart = selection.size();
+
+    for (size_t row = previous; row < result.rows.size(); ++row)
+    {
+        order.push_back(static_cast<uint32_t>(row));
+        if (filterNeedle.empty() || matches[row])
+            selection.push_back(static_cast<uint32_t>(row));
+    }
+
+    version++;
+}
+
+void ResultView::appendSorted(const QueryResult& result, size_t previous)
+{
+    // A page that turns the column from numbers into text, or the other way, orders every row differently
+    bool numeric = isNumericSort();
+    scanColumn(result, sortColumn, previous, result.rows.size());
+    if (isNumericSort() != numeric)
+    {
+        sort(result, sortColumn, sortOrder);
+        return;
+    }
+
+    size_t column = static_cast<size_t>(sortColumn);
+    bool descending = sortOrder == SortOrder::DESCENDING;
+    computeSortKeys(result, previous, result.rows.size());
+
+    // Same order as sort(): NULL first ascending and last descending, values by their keys, ties in server order.
+    // Text only has to be read when the first eight bytes are the same.
+    auto less = [&](uint32_t a, uint32_t b) {
+        if (sortNulls[a] != sortNulls[b])
+            return (sortNulls[a] != 0) != descending;
+
+        if (!sortNulls[a])
+        {
+            int compared = sortKeys[a] < sortKeys[b] ? -1 : sortKeys[a] > sortKeys[b] ? 1 : 0;
+            if (compared == 0 && !numeric)
+                compared = compareText(cellAt(result, a, column), cellAt(result, b, column));
+            if (compared != 0)
+                return descending ? compared > 0 : compared < 0;
+        }
+
+        return a < b;
+    };
+
+    std::vector<uint32_t> added(result.rows.size() - previous);
+    std::iota(added.begin(), added.end(), static_cast<uint32_t>(previous));
+    std::sort(added.begin(), added.end(), less);
+    mergeRows(order, added, less);
+
+    if (!filterNeedle.empty())
+        added.erase(std::remove_if(added.begin(), added.end(), [&](uint32_t row) { return !matches[row]; }), added.end());
+    mergeRows(selection, added, less);
+
+    // Rows went into the middle, the view changed as a whole
+    appendBase = ~0ull;
+    version++;
+}
+
+template <typename Less>
+void ResultView::mergeRows(std::vector<uint32_t>& rows, const std::vector<uint32_t>& added, const Less& less)
+{
+    // Each new row finds its place by binary search and the rows in between move as blocks, so a page costs
+    // log(n) comparisons per new row instead of one per existing row
+    std::vector<uint32_t> merged;
+    merged.reserve(rows.size() + added.size());
+
+    auto from = rows.begin();
+    for (uint32_t row : added)
+    {
+        auto at = std::upper_bound(from, rows.end(), row, less);
+        merged.insert(merged.end(), from, at);
+        merged.push_back(row);
+        from = at;
+    }
+    merged.insert(merged.end(), from, rows.end());
+
+    rows.swap(merged);
+}
+
+bool ResultView::extends(uint64_t olderVersion, size_t& firstNew) const
+{
+    if (olderVersion != appendBase || version != appendBase + 1)
+        return false;
+
+    firstNew = appendStart;
+    return true;
+}
+
+void ResultView::matchRows(const QueryResult& result, size_t first, size_t last)
+{
+    Parallel::forEach(last - first, PARALLEL_THRESHOLD / 4, [&](size_t begin, size_t end) {
+        for (size_t row = first + begin; row < first + end; ++row)
+        {
+            for (const auto& cell : result.rows[row])
+            {
+                if (containsNoCase(cell, filterNeedle))
+                {
+                    matches[row] = 1;
+                    break;
+                }
+            }
+        }
+    });
+}
+
+ResultView::SortOrder ResultView::nextOrder(size_t column) const
+{
+    if (sortColumn != static_cast<int>(column))
+        return SortOrder::ASCENDING;
+
+    return sortOrder == SortOrder::ASCENDING ? SortOrder::DESCENDING : SortOrder::NONE;
+}
+
+void ResultView::applySelection()
+{
+    appendBase = ~0ull;
+
+    if (filterNeedle.empty())
+    {
+        selection = order;
+    }
+    else
+    {
+        selection.clear();
+        for (uint32_t row : order)
+        {
+            if (row < matches.size() && matches[row])
+                selection.push_back(row);
+        }
+    }
+
+    version++;
+}
+
+void ResultView::scanColumn(const QueryResult& result, size_t column, size_t first, size_t last)
+{
+    for (size_t row = first; row < last && !sortHasText; ++row)
+    {
+        const auto& cells = result.rows[row];
+        if (column >= cells.size() || cells[column].empty() || isNull(cells[column]))
+            continue;
+
+        const char* begin = cells[column].c_str();
+        char* end = nullptr;
+        std::strtod(begin, &end);
+        if (end != begin + cells[column].size())
+            sortHasText = true;
+
+        sortHasValues = true;
+    }
+}
+
+void ResultView::computeSortKeys(const QueryResult& result, size_t first, size_t last)
+{
+    size_t column = static_cast<size_t>(sortColumn);
+    bool numeric = isNumericSort();
+
+    sortKeys.resize(last);
+    sortNulls.resize(last);
+    Parallel::forEach(last - first, PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        for (size_t row = first + begin; row < first + end; ++row)
+        {
+            const std::string& value = cellAt(result, static_cast<uint32_t>(row), column);
+            bool null = isNull(value) || (numeric && value.empty());
+
+            sortKeys[row] = null ? 0 : numeric ? numericKey(std::strtod(value.c_str(), nullptr)) : prefixKey(value);
+            sortNulls[row] = null;
+        }
+    });
+}
+
+int ResultView::compareText(const std::string& left, const std::string& right)
+{
+    // Sort keys pad the shorter string with zero bytes, trailing zeros therefore compare equal
+    size_t common = std::min(left.size(), right.size());
+    if (int compared = std::memcmp(left.data(), right.data(), common))
+        return compared < 0 ? -1 : 1;
+
+    const std::string& longer = left.size() > right.size() ? left : right;
+    for (size_t i = common; i < longer.size(); ++i)
+    {
+        if (longer[i] != '\0')
+            return &longer == &left ? 1 : -1;
+    }
+    return 0;
+}
+
+bool ResultView::containsNoCase(const std::string& haystack, const std::string& lowerNeedle)
+{
+    if (lowerNeedle.size() > haystack.size())
+        return false;
+
+    const char* data = haystack.data();
+    size_t last = haystack.size() - lowerNeedle.size();
+    int lower = static_cast<unsigned char>(lowerNeedle[0]);
+    int upper = std::toupper(lower);
+
+    // memchr is vectorized by the C library, so candidates for either case of the first byte are found
+    // a block at a time and only those are compared byte by byte
+    auto find = [&](int c, size_t from) -> size_t {
+        const void* hit = std::memchr(data + from, c, last - from + 1);
+        return hit ? static_cast<const char*>(hit) - data : std::string::npos;
+    };
+
+    size_t nextLower = find(lower, 0);
+    size_t nextUpper = upper != lower ? find(upper, 0) : std::string::npos;
+
+    while (nextLower != std::string::npos || nextUpper != std::string::npos)
+    {
+        size_t at = std::min(nextLower, nextUpper);
+
+        size_t i = 1;
+        while (i < lowerNeedle.size() && std::tolower(static_cast<unsigned char>(data[at + i])) == static_cast<unsigned char>(lowerNeedle[i]))
+            i++;
+        if (i == lowerNeedle.size())
+            return true;
+
+        if (at == last)
+            return false;
+        if (at == nextLower)
+            nextLower = find(lower, at + 1);
+        if (at == nextUpper)
+            nextUpper = find(upper, at + 1);
+    }
+
+    return false;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../../models/QueryResult.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Client-side sort and filter over a loaded QueryResult. The rows never move: sorting produces an index
+// permutation from keys computed once per column, filtering narrows that permutation to a selection vector.
+class ResultView
+{
+public:
+    enum class SortOrder
+    {
+        NONE,
+        ASCENDING,
+        DESCENDING
+    };
+
+public:
+    // Back to the server's row order with no filter
+    void reset(const QueryResult& result);
+
+    void sort(const QueryResult& result, size_t column, SortOrder order);
+    void filter(const QueryResult& result, const std::string& text);
+
+    // Takes in rows appended to the result since the last call, keeping the current sort and filter
+    void append(const QueryResult& result);
+
+    // Next order when a column header is clicked: ascending, descending, then back to unsorted
+    SortOrder nextOrder(size_t column) const;
+
+    size_t size() const { return selection.size(); }
+    size_t totalRows() const { return order.size(); }
+    uint32_t rowAt(size_t index) const { return selection[index]; }
+    const std::vector<uint32_t>& rows() const { return selection; }
+
+    int getSortColumn() const { return sortColumn; }
+    SortOrder getSortOrder() const { return sortOrder; }
+    const std::string& getFilterText() const { return filterText; }
+
+    // Changes whenever the visible rows or their order change
+    uint64_t getVersion() const { return version; }
+
+    // True if the only change since olderVersion is rows added at the end, starting at firstNew
+    bool extends(uint64_t olderVersion, size_t& firstNew) const;
+
+private:
+    void applySelection();
+    void matchRows(const QueryResult& result, size_t first, size_t last);
+    void appendSorted(const QueryResult& result, size_t previous);
+
+    // Notes whether rows [first, last) of the column hold any values, and any that are not numbers
+    void scanColumn(const QueryResult& result, size_t column, size_t first, size_t last);
+    bool isNumericSort() const { return sortHasValues && !sortHasText; }
+    void computeSortKeys(const QueryResult& result, size_t first, size_t last);
+
+    template <typename Less>
+    static void mergeRows(std::vector<uint32_t>& rows, const std::vector<uint32_t>& added, const Less& less);
+    static int compareText(const std::string& left, const std::string& right);
+    static bool containsNoCase(const std::string& haystack, const std::string& lowerNeedle);
+
+private:
+    std::vector<uint32_t> order;     // Every row, in display order
+    std::vector<uint32_t> selection; // Rows of order that pass the filter, same order
+    std::vector<uint8_t> matches;    // Filter result per data row, empty when there is no filter
+    std::vector<uint64_t> sortKeys;  // Number, or first eight bytes of text, per data row of the sorted column
+    std::vector<uint8_t> sortNulls;  // Whether the sorted column is NULL per data row
+
+    int sortColumn = -1;
+    SortOrder sortOrder = SortOrder::NONE;
+    bool sortHasText = false;   // Sorted column holds a value that is not a number
+    bool sortHasValues = false; // Sorted column holds any value that is not NULL or empty
+    std::string filterText;
+    std::string filterNeedle; // Lowercased filter text
+    uint64_t version = 0;
+    uint64_t appendBase = ~0ull; // Version the last append extended, if nothing else changed since
+    size_t appendStart = 0;
+
+private:
+    static constexpr size_t PARALLEL_THRESHOLD = 1 << 15; // Below this a single thread is faster
+};
@@ -0,0 +1,250 @@
+#include "FuzzyIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+std::string toLower(std::string_view text)
+{
+    std::string result(text);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+bool isWordStart(std::string_view name, size_t pos)
+{
+    return pos == 0 || name[pos - 1] == '_' || name[pos - 1] == '.' || name[pos - 1] == '-' || name[pos - 1] == ' ';
+}
+} // namespace
+
+void FuzzyIndex::build(const std::vector<std::string>& names)
+{
+    clear();
+    lowered.reserve(names.size());
+
+    for (uint32_t id = 0; id < names.size(); ++id)
+    {
+        lowered.push_back(toLower(names[id]));
+        const std::string& name = lowered.back();
+
+        for (size_t pos = 0; pos + 3 <= name.size(); ++pos)
+        {
+            auto& ids = postings[trigramKey(name, pos)];
+            if (ids.empty() || ids.back() != id)
+                ids.push_back(id);
+        }
+
+        for (size_t pos = 0; pos < name.size(); ++pos)
+        {
+            if (isWordStart(name, pos))
+                wordStarts.push_back({id, static_cast<uint32_t>(pos)});
+        }
+    }
+
+    std::sort(wordStarts.begin(), wordStarts.end(), [this](const WordStart& a, const WordStart& b) {
+        int compared = suffix(a).compare(suffix(b));
+        return compared != 0 ? compared < 0 : a.id < b.id;
+    });
+
+    trigramCounts.assign(lowered.size(), 0);
+    matched.assign(lowered.size(), 0);
+}
+
+void FuzzyIndex::clear()
+{
+    lowered.clear();
+    postings.clear();
+    wordStarts.clear();
+    trigramCounts.clear();
+    matched.clear();
+    lastQuery.clear();
+    lastHits.clear();
+}
+
+std::vector<FuzzyIndex::Match> FuzzyIndex::search(const std::string& query, size_t limit)
+{
+    std::vector<Match> matches;
+    std::string needle = toLower(query);
+    if (needle.empty())
+        return matches;
+
+    // Once a query was long enough for its trigrams, every candidate of a query extending it was one of its
+    // candidates too, and a subsequence hit of the longer query is a hit of the shorter one
+    bool narrowing = lastQuery.size() >= 3 && needle.compare(0, lastQuery.size(), lastQuery) == 0;
+    std::vector<uint32_t> candidates;
+
+    if (narrowing)
+    {
+        candidates.swap(lastHits);
+    }
+    else
+    {
+        // Substring hits hold every trigram of the query, subsequence hits usually start where a word of the name does
+        if (needle.size() >= 3)
+            addTrigramCandidates(needle, candidates);
+        addPrefixCandidates(std::string_view(needle).substr(0, PREFIX_LENGTH), candidates);
+
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    lastHits.clear();
+    for (uint32_t id : candidates)
+    {
+        int score = subsequenceScore(lowered[id], needle);
+        if (score < 0)
+            continue;
+        lastHits.push_back(id);
+        matches.push_back({id, score});
+    }
+    lastQuery = needle;
+
+    if (matches.size() < limit)
+        addTypoMatches(needle, matches);
+
+    auto better = [this](const Match& a, const Match& b) {
+        if (a.score != b.score)
+            return a.score > b.score;
+        if (lowered[a.id].size() != lowered[b.id].size())
+            return lowered[a.id].size() < lowered[b.id].size();
+        return a.id < b.id;
+    };
+
+    if (matches.size() > limit)
+    {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), better);
+        matches.resize(limit);
+    }
+    else
+    {
+        std::sort(matches.begin(), matches.end(), better);
+    }
+
+    return matches;
+}
+
+void FuzzyIndex::addPrefixCandidates(std::string_view prefix, std::vector<uint32_t>& candidates) const
+{
+    auto first = std::lower_bound(wordStarts.begin(), wordStarts.end(), prefix,
+                                  [this](const WordStart& start, std::string_view value) { return suffix(start) < value; });
+
+    for (auto it = first; it != wordStarts.end() && suffix(*it).substr(0, prefix.size()) == prefix; ++it)
+        candidates.push_back(it->id);
+}
+
+void FuzzyIndex::addTrigramCandidates(std::string_view query, std::vector<uint32_t>& candidates) const
+{
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (uint32_t trigram : trigramsOf(query))
+    {
+        auto it = postings.find(trigram);
+        if (it == postings.end())
+            return;
+        lists.push_back(&it->second);
+    }
+
+    // Shortest list first, the others are only probed for the ids still left
+    std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+    std::vector<uint32_t> common = *lists.front();
+    for (size_t i = 1; i < lists.size() && !common.empty(); ++i)
+    {
+        const auto& ids = *lists[i];
+        common.erase(std::remove_if(common.begin(), common.end(),
+                                    [&ids](uint32_t id) { return !std::binary_search(ids.begin(), ids.end(), id); }),
+                     common.end());
+    }
+
+    candidates.insert(candidates.end(), common.begin(), common.end());
+}
+
+void FuzzyIndex::addTypoMatches(const std::string& query, std::vector<Match>& matches)
+{
+    if (query.size() < 4)
+        return;
+
+    std::vector<uint32_t> trigrams = trigramsOf(query);
+
+    for (const auto& match : matches)
+        matched[match.id] = 1;
+
+    std::vector<uint32_t> touched;
+    for (uint32_t trigram : trigrams)
+    {
+        auto it = postings.find(trigram);
+        if (it == postings.end())
+            continue;
+
+        for (uint32_t id : it->second)
+        {
+            if (trigramCounts[id]++ == 0)
+                touched.push_back(id);
+        }
+    }
+
+    // Sharing at least half of the query's trigrams is close enough to be worth showing below real matches
+    size_t required = (trigrams.size() + 1) / 2;
+    for (uint32_t id : touched)
+    {
+        if (!matched[id] && trigramCounts[id] >= required)
+            matches.push_back({id, static_cast<int>(TYPO_SCORE * trigramCounts[id] / trigrams.size())});
+        trigramCounts[id] = 0;
+    }
+
+    for (const auto& match : matches)
+        matched[match.id] = 0;
+}
+
+int FuzzyIndex::subsequenceScore(std::string_view name, std::string_view query)
+{
+    int lengthPenalty = static_cast<int>(std::min<size_t>(name.size(), 500));
+
+    if (name == query)
+        return EXACT_SCORE;
+
+    size_t found = name.find(query);
+    if (found == 0)
+        return PREFIX_SCORE - lengthPenalty;
+    if (found != std::string_view::npos)
+        return SUBSTRING_SCORE - lengthPenalty - static_cast<int>(std::min<size_t>(found, 500)) + (isWordStart(name, found) ? 200 : 0);
+
+    // Greedy left-to-right match, rewarding runs and word starts and charging for skipped characters
+    int score = SUBSEQUENCE_SCORE - lengthPenalty;
+    size_t previous = std::string_view::npos;
+    size_t pos = 0;
+
+    for (char c : query)
+    {
+        pos = name.find(c, pos);
+        if (pos == std::string_view::npos)
+            return -1;
+
+        if (previous != std::string_view::npos && pos == previous + 1)
+            score += 15;
+        else if (isWordStart(name, pos))
+            score += 10;
+        else
+            score -= static_cast<int>(std::min<size_t>(pos - (previous == std::string_view::npos ? 0 : previous + 1), 20));
+
+        previous = pos++;
+    }
+
+    return score;
+}
+
+std::vector<uint32_t> FuzzyIndex::trigramsOf(std::string_view text)
+{
+    std::vector<uint32_t> trigrams;
+    for (size_t pos = 0; pos + 3 <= text.size(); ++pos)
+        trigrams.push_back(trigramKey(text, pos));
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+uint32_t FuzzyIndex::trigramKey(std::string_view text, size_t pos)
+{
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8 | static_cast<unsigned char>(text[pos + 2]);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Ranked name lookup for the object list. Candidates come from two indexes, never from a scan of every name:
+// queries of three or more characters intersect the posting lists of their trigrams, and every query looks up
+// the names with a word starting with its first characters in a sorted list of word starts ("usord" finds
+// "user_orders"). Candidates are ranked as case-insensitive subsequences, exact, prefix and substring hits
+// first. When that leaves room, names sharing most of the query's trigrams are added so a typo still finds them.
+// A query extending the previous one only rescans the previous hits.
+class FuzzyIndex
+{
+public:
+    struct Match
+    {
+        uint32_t id; // Position of the name in the vector passed to build()
+        int score;
+    };
+
+public:
+    void build(const std::vector<std::string>& names);
+    void clear();
+
+    // Best matches first, at most limit of them
+    std::vector<Match> search(const std::string& query, size_t limit);
+
+    size_t size() const { return lowered.size(); }
+
+private:
+    struct WordStart
+    {
+        uint32_t id;
+        uint32_t offset; // Start of the word within the lowered name
+    };
+
+    static int subsequenceScore(std::string_view name, std::string_view query);
+    static uint32_t trigramKey(std::string_view text, size_t pos);
+    static std::vector<uint32_t> trigramsOf(std::string_view text);
+    std::string_view suffix(const WordStart& start) const { return std::string_view(lowered[start.id]).substr(start.offset); }
+
+    void addPrefixCandidates(std::string_view prefix, std::vector<uint32_t>& candidates) const;
+    void addTrigramCandidates(std::string_view query, std::vector<uint32_t>& candidates) const;
+    void addTypoMatches(const std::string& query, std::vector<Match>& matches);
+
+private:
+    std::vector<std::string> lowered;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings; // Trigram to the ascending ids of names containing it
+    std::vector<WordStart> wordStarts;                            // Sorted by the text from the word start on
+
+    // Previous query and the names that matched it as a subsequence
+    std::string lastQuery;
+    std::vector<uint32_t> lastHits;
+
+    // Scratch space reused between searches, one slot per name
+    std::vector<uint16_t> trigramCounts;
+    std::vector<uint8_t> matched;
+
+private:
+    static constexpr int EXACT_SCORE = 10000;
+    static constexpr int PREFIX_SCORE = 9000;
+    static constexpr int SUBSTRING_SCORE = 8000;
+    static constexpr int SUBSEQUENCE_SCORE = 5000;
+    static constexpr int TYPO_SCORE = 2000;
+    static constexpr size_t PREFIX_LENGTH = 2; // Characters of a longer query looked up among the word starts
+};
@@ -2,10 +2,14 @@
 
 #include "states/ApplicationState.h"
 #include "commands/CommandFactory.h"
+#include "core/FramePacer.h"
+#include "core/FrameStats.h"
+#include "components/TextLayoutCache.h"
+#include "../core/database/SchemaSnapshot.h"
+#include "../core/logging/Logger.h"
 
 #include <ctime>
 #include <filesystem>
-#include <iostream>
 #include <typeinfo>
 
 #include <raylib.h>
@@ -40,14 +44,58 @@ GuiManager::GuiManager(int screenWidth, int screenHeight)
         handleTableStructure(tableName);
     });
 
+    erDiagram->setTableClickCallback([this](const std::string& tableName) {
+        expandDiagram(tableName);
+    });
+
+    erDiagram->setShowAllCallback([this]() {
+        selectedTable.clear();
+        try
+        {
+            openWholeDiagram();
+        }
+        catch (const std::exception& e)
+        {
+            publishEvent<EventType::ErrorOccurred>(ErrorData{std::string("Failed to load the diagram: ") + e.what(), true});
+        }
+    });
+
+    setupSubscriptions();
+
     m_state = std::make_unique<DisconnectedState>();
 }
 
-GuiManager::~GuiManager() {}
+GuiManager::~GuiManager()
+{
+    auto& bus = EventBus::getInstance();
+
+    for (const auto& [type, id] : subscriptionIds)
+        bus.unsubscribe(type, id);
+
+    // Closing the window with the diagram open keeps the arrangement as well
+    if (erDiagram)
+        erDiagram->saveLayout();
+}
+
+// The selected table belongs to the database it was picked in, another one must not open focused on it
+void GuiManager::setupSubscriptions()
+{
+    auto& bus = EventBus::getInstance();
+
+    subscriptionIds.emplace_back(EventType::ServerDisconnected, bus.subscribe<EventType::ServerDisconnected>([this](const auto&) {
+        selectedTable.clear();
+    }));
+
+    subscriptionIds.emplace_back(EventType::DatabaseConnected, bus.subscribe<EventType::DatabaseConnected>([this](const auto&) {
+        selectedTable.clear();
+    }));
+}
 
 void GuiManager::initialize()
 {
     InitWindow(screenWidth, screenHeight, "BodyaSQL");
+
+    // 60 FPS is only the ceiling while something is going on, see FramePacer
     SetTargetFPS(60);
 }
 
@@ -56,7 +104,7 @@ void GuiManager::handleTableClick(const std::string& name)
     if (!getConnected() || !m_query)
         return;
 
-    std::cout << "Object clicked: " << name << std::endl;
+    LOG_DEBUG("Object clicked: " << name);
 
     latestTableResult.isVisible = true;
     queryPanel->setObjectsVisibility(true);
@@ -65,6 +113,8 @@ void GuiManager::handleTableClick(const std::string& name)
     std::string query;
 
     auto objectType = resultsPanel->getCurrentObjectType();
+    if (objectType == ScrollableList::DatabaseObjectType::Table)
+        selectedTable = name;
 
     switch (objectType)
     {
@@ -110,8 +160,111 @@ void GuiManager::handleTableStructure(const std::string& tableName)
         }
         catch (const std::exception& e)
         {
-            publishEvent(EventType::ErrorOccurred, ErrorData{std::string("Failed to get table structure: ") + e.what(), true});
+            publishEvent<EventType::ErrorOccurred>(ErrorData{std::string("Failed to get table structure: ") + e.what(), true});
+        }
+    }
+}
+
+void GuiManager::openDiagram()
+{
+    if (!selectedTable.empty() && m_tableManager)
+    {
+        auto neighborhood = m_tableManager->getNeighborhood({selectedTable}, ERDiagram::FOCUS_HOPS);
+        if (neighborhood.schemaTables > ERDiagram::FOCUS_THRESHOLD && !neighborhood.tables.empty())
+        {
+            openFocusedDiagram(selectedTable, neighborhood.tables);
+            return;
+        }
+    }
+
+    openWholeDiagram();
+}
+
+// Shows the current schema, from memory when the diagram still holds it, then from the saved layout, and only
+// reads the catalog when the schema changed since. The fingerprint query is the one round trip in the first two cases.
+void GuiManager::openWholeDiagram()
+{
+    if (!m_dbManager || !m_query)
+        throw std::runtime_error("Database connection not initialized");
+
+    std::string path = DiagramStore::pathFor(m_dbManager->getServerAddress(), m_dbManager->getCurrentDatabase());
+    std::string fingerprint = SchemaSnapshot::readFingerprint(*m_query);
+
+    bool current = erDiagram->getStorePath() == path && erDiagram->getFingerprint() == fingerprint;
+    if (!fingerprint.empty() && !erDiagram->isEmpty() && current)
+    {
+        LOG_DEBUG("Diagram is up to date");
+        return;
+    }
+
+    DiagramStore::Saved saved;
+    bool stored = DiagramStore::load(path, saved);
+
+    erDiagram->clear();
+    if (stored && !fingerprint.empty() && saved.fingerprint == fingerprint)
+    {
+        LOG_INFO("Loading database structure from " << path);
+        for (const auto& table : saved.tables)
+            erDiagram->addTable(table.name, table.columns);
+    }
+    else
+    {
+        LOG_INFO("Loading database structure...");
+        SchemaSnapshot schema = SchemaSnapshot::read(*m_query);
+        fingerprint = schema.fingerprint;
+        erDiagram->addTables(schema);
+    }
+
+    erDiagram->setSource(path, fingerprint);
+    if (stored)
+        erDiagram->placeTables(saved);
+    else
+        erDiagram->layoutTables();
+}
+
+// Only the neighbourhood is read and laid out, so opening costs the same in a schema of any size.
+// Focused diagrams are not saved, their arrangement would overwrite the one of the whole schema.
+void GuiManager::openFocusedDiagram(const std::string& tableName, const std::vector<std::string>& tables)
+{
+    if (erDiagram->getFocus() == tableName && !erDiagram->isEmpty())
+        return;
+
+    erDiagram->saveLayout();
+
+    LOG_INFO("Loading " << tables.size() << " tables around " << tableName);
+    erDiagram->clear();
+    erDiagram->addTables(SchemaSnapshot::read(*m_query, tables));
+    erDiagram->setFocus(tableName);
+    erDiagram->layoutTables();
+}
+
+void GuiManager::expandDiagram(const std::string& tableName)
+{
+    if (!m_tableManager || !m_query)
+        return;
+
+    try
+    {
+        std::vector<std::string> missing;
+        for (const auto& name : m_tableManager->getNeighborhood({tableName}, 1).tables)
+        {
+            if (!erDiagram->hasTable(name))
+                missing.push_back(name);
+        }
+
+        if (missing.empty())
+        {
+            LOG_DEBUG("All neighbours of " << tableName << " are already shown");
+            return;
         }
+
+        LOG_INFO("Adding " << missing.size() << " neighbours of " << tableName);
+        erDiagram->addTables(SchemaSnapshot::read(*m_query, missing));
+        erDiagram->layoutTables();
+    }
+    catch (const std::exception& e)
+    {
+        publishEvent<EventType::ErrorOccurred>(ErrorData{std::string("Failed to expand the diagram: ") + e.what(), true});
     }
 }
 
@@ -164,7 +317,7 @@ void GuiManager::renderPanels(const LatestQueryResult& latestResult, const Lates
 
         if (latestTableResult.isVisible)
         {
-            std::cout << "Rendering table list with " << latestTableResult.tableNames.size() << " tables" << std::endl;
+            LOG_TRACE("Rendering table list with " << latestTableResult.tableNames.size() << " tables");
             resultsPanel->renderTableList(latestTableResult.tableNames);
         }
     }
@@ -186,14 +339,14 @@ void GuiManager::transitionToQueryState()
 {
     if (!dynamic_cast<QueryState*>(m_state.get()))
     {
-        std::cout << "Transitioning to QueryState from " << typeid(*m_state).name() << "\n";
+        LOG_INFO("Transitioning to QueryState from " << typeid(*m_state).name());
         if (verifyDatabaseConnection())
         {
             setState(std::make_unique<QueryState>());
         }
         else
         {
-            std::cout << "Failed to transition to QueryState - database objects not initialized\n";
+            LOG_ERROR("Failed to transition to QueryState - database objects not initialized");
             connectionPanel->setState(ConnectionPanel::ConnectionState::SERVER_CONNECTED);
         }
     }
@@ -203,7 +356,7 @@ void GuiManager::transitionToConnectedState()
 {
     if (!dynamic_cast<ConnectedState*>(m_state.get()))
     {
-        std::cout << "Transitioning to ConnectedState\n";
+        LOG_INFO("Transitioning to ConnectedState");
         setState(std::make_unique<ConnectedState>());
     }
 }
@@ -212,7 +365,7 @@ void GuiManager::transitionToDisconnectedState()
 {
     if (!dynamic_cast<DisconnectedState*>(m_state.get()))
     {
-        std::cout << "Transitioning to DisconnectedState\n";
+        LOG_INFO("Transitioning to DisconnectedState");
         setState(std::make_unique<DisconnectedState>());
         resetDatabaseManager();
         resetTableManager();
@@ -220,24 +373,20 @@ void GuiManager::transitionToDisconnectedState()
     }
 }
 
-void GuiManager::updateResults(LatestQueryResult& latestResult, LatestTableResult& latestTableResult)
-{
-    latestResult = this->latestResult;
-    latestTableResult = this->latestTableResult;
-}
-
 void GuiManager::handleExitConditions(bool& shouldClose)
 {
     if (connectionPanel->handleExit() || WindowShouldClose())
         shouldClose = true;
 }
 
-void GuiManager::render(bool& shouldClose, LatestQueryResult& latestResult, LatestTableResult& latestTableResult, Message& errorMsg)
+void GuiManager::render(bool& shouldClose)
 {
     logState();
+    FrameStats::beginFrame();
 
-    this->latestResult = latestResult;
-    this->latestTableResult = latestTableResult;
+    if (IsWindowResized())
+        TextLayoutCache::clear();
+    TextLayoutCache::beginFrame();
 
     BeginDrawing();
     {
@@ -250,11 +399,11 @@ void GuiManager::render(bool& shouldClose, LatestQueryResult& latestResult, Late
 
         executePendingCommands();
 
-        renderPanels(this->latestResult, this->latestTableResult);
+        renderPanels(latestResult, latestTableResult);
 
         if (queryPanel->getERDiagramVisibility())
         {
-            std::cout << "ER Diagram is visible, rendering..." << std::endl;
+            LOG_TRACE("ER Diagram is visible, rendering...");
             erDiagram->update();
             erDiagram->render();
         }
@@ -262,16 +411,15 @@ void GuiManager::render(bool& shouldClose, LatestQueryResult& latestResult, Late
         handleExitConditions(shouldClose);
 
         messageSystem->render(GetFrameTime());
+
+        FramePacer::endFrame(messageSystem->isAnimating());
+        FrameStats::endFrame();
     }
     EndDrawing();
-
-    updateResults(latestResult, latestTableResult);
 }
 
 void GuiManager::logState() const
 {
-    std::cout << "Current state: " << (m_state ? typeid(*m_state).name() : "null") << "\n"
-              << "DatabaseManager: " << (m_dbManager ? "initialized" : "null") << "\n"
-              << "TableManager: " << (m_tableManager ? "initialized" : "null") << "\n"
-              << "Query: " << (m_query ? "initialized" : "null") << "\n";
+    LOG_TRACE("State: " << (m_state ? typeid(*m_state).name() : "null") << ", database manager: " << (m_dbManager ? "set" : "null")
+                        << ", table manager: " << (m_tableManager ? "set" : "null") << ", query: " << (m_query ? "set" : "null"));
 }
@@ -45,7 +45,9 @@ public:
 
 public:
     void initialize();
-    void render(bool& shouldClose, LatestQueryResult& latestResult, LatestTableResult& latestTableResult, Message& errorMsg);
+
+    // Results live only here; panels and commands work on them by reference, nothing is copied per frame
+    void render(bool& shouldClose);
 
 public:
     std::shared_ptr<ConnectionPanel> getConnectionPanel() const { return connectionPanel; }
@@ -73,10 +75,10 @@ public:
     void resetQuery() { m_query.reset(); }
 
 
-    template <typename T>
-    void publishEvent(EventType type, T data)
+    template <EventType Type>
+    void publishEvent(const EventBus::Payload<Type>& data = {})
     {
-        EventBus::getInstance().publish(type, std::any(std::move(data)));
+        EventBus::getInstance().publish<Type>(data);
     }
 
 public:
@@ -85,6 +87,9 @@ public:
 
     bool verifyDatabaseConnection() const { return m_dbManager && m_tableManager && m_query; }
 
+    // Loads the diagram for the current schema, focused on the selected table when the schema is large
+    void openDiagram();
+
     void logState() const;
 
     void executePendingCommands() { CommandExecutor::executeCommands(m_pendingCommands);
@@ -102,7 +107,11 @@ private:
     void handleExportOperations(const LatestQueryResult& latestResult);
     void handleStateTransitions();
     void handleTableStructure(const std::string& tableName);
+    void openWholeDiagram();
+    void openFocusedDiagram(const std::string& tableName, const std::vector<std::string>& tables);
+    void expandDiagram(const std::string& tableName);
     void handleExitConditions(bool& shouldClose);
+    void setupSubscriptions();
 
 private:
     void renderBackground() const;
@@ -112,7 +121,6 @@ private:
     void transitionToQueryState();
     void transitionToConnectedState();
     void transitionToDisconnectedState();
-    void updateResults(LatestQueryResult& latestResult, LatestTableResult& latestTableResult);
 
 
 private:
@@ -130,10 +138,13 @@ private:
 private:
     LatestTableResult latestTableResult;
     LatestQueryResult latestResult;
+    std::string selectedTable; // Last table opened from the object list, the diagram focuses on it
 
     std::unique_ptr<ApplicationState> m_state;
 
     std::unique_ptr<DatabaseManager> m_dbManager;
     std::unique_ptr<TableManager> m_tableManager;
     std::unique_ptr<Query> m_query;
+
+    std::vector<std::pair<EventType, EventBus::SubscriberId>> subscriptionIds;
 };
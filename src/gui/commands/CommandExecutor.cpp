@@ -1,6 +1,6 @@
 #include "CommandExecutor.h"
 
-#include <iostream>
+#include "../../core/logging/Logger.h"
 
 void CommandExecutor::executeCommands(std::vector<std::unique_ptr<DatabaseCommand>>& commands)
 {
@@ -13,7 +13,7 @@ void CommandExecutor::executeCommands(std::vector<std::unique_ptr<DatabaseComman
         }
         catch (const std::exception& e)
         {
-            std::cerr << "Command execution failed: " << e.what() << std::endl;
+            LOG_ERROR("Command execution failed: " << e.what());
             throw;
         }
     }
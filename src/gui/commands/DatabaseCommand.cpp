@@ -2,9 +2,9 @@
 
 #include "../GuiManager.h"
 #include "../core/EventData.h"
+#include "../../core/logging/Logger.h"
 
 #include <filesystem>
-#include <iostream>
 
 ConnectToServerCommand::ConnectToServerCommand(std::unique_ptr<DatabaseManager>& dbManager, const DatabaseConnectionInfo& connInfo,
                                                ConnectionPanel& connectionPanel)
@@ -24,11 +24,11 @@ void ConnectToServerCommand::execute()
         auto databases = m_dbManager->getDatabases();
         m_connectionPanel.setAvailableDatabases(databases);
 
-        publishEvent(EventType::ServerConnected, DatabaseConnectedData{"", true});
+        publishEvent<EventType::ServerConnected>(DatabaseConnectedData{"", true});
     }
     catch (const std::exception& e)
     {
-        publishEvent(EventType::ErrorOccurred, ErrorData{e.what(), true});
+        publishEvent<EventType::ErrorOccurred>(ErrorData{e.what(), true});
         m_dbManager.reset();
     }
 }
@@ -47,39 +47,39 @@ void ConnectToDatabaseCommand::execute()
 {
     try
     {
-        std::cout << "Executing ConnectToDatabaseCommand for database: " << m_dbName << std::endl;
+        LOG_INFO("Executing ConnectToDatabaseCommand for database: " << m_dbName);
 
         if (!m_dbManager)
             throw std::runtime_error("DatabaseManager is not initialized");
 
         m_dbManager->connectToDatabase(m_dbName);
 
-        std::cout << "Initializing TableManager..." << std::endl;
+        LOG_DEBUG("Initializing TableManager...");
         m_tableManager = std::make_unique<TableManager>(m_dbManager->getSession(), m_dbName);
 
         if (!m_tableManager)
             throw std::runtime_error("Failed to initialize TableManager");
 
-        std::cout << "Initializing Query object..." << std::endl;
+        LOG_DEBUG("Initializing Query object...");
         m_query = std::make_unique<Query>(m_dbManager->getSession(), *m_tableManager);
 
         if (!m_query)
             throw std::runtime_error("Failed to initialize Query object");
 
         auto tables = m_tableManager->getTableNames();
-        publishEvent(EventType::TablesLoaded, TablesLoadedData{tables, std::vector<std::string>(), std::vector<std::string>(),
+        publishEvent<EventType::TablesLoaded>(TablesLoadedData{tables, std::vector<std::string>(), std::vector<std::string>(),
                                                                std::vector<std::string>(), true});
 
-        std::cout << "Database connection and initialization successful" << std::endl;
-        publishEvent(EventType::DatabaseConnected, DatabaseConnectedData{m_dbName, true});
+        LOG_INFO("Database connection and initialization successful");
+        publishEvent<EventType::DatabaseConnected>(DatabaseConnectedData{m_dbName, true});
     }
     catch (const std::exception& e)
     {
-        std::cerr << "Database connection failed: " << e.what() << "\n";
-        publishEvent(EventType::ErrorOccurred, ErrorData{e.what(), true});
+        LOG_ERROR("Database connection failed: " << e.what());
+        publishEvent<EventType::ErrorOccurred>(ErrorData{e.what(), true});
         m_tableManager.reset();
         m_query.reset();
-        publishEvent(EventType::StateReset, std::any());
+        publishEvent<EventType::StateReset>();
     }
 }
 
@@ -97,25 +97,31 @@ void ExecuteQueryCommand::execute()
         if (!m_query)
             throw std::runtime_error("Query object is not initialized");
 
-        std::cout << "Executing query: " << m_queryText << std::endl;
+        LOG_INFO("Executing query: " << m_queryText);
 
         if (m_queryText.empty())
         {
-            publishEvent(EventType::ErrorOccurred, ErrorData{"Query cannot be empty", false});
+            publishEvent<EventType::ErrorOccurred>(ErrorData{"Query cannot be empty", false});
             return;
         }
 
-        auto result = m_query->execute(m_queryText);
-        m_resultOutput = result;
-        publishEvent(EventType::QueryExecuted, QueryExecutedData{result, true, ""});
-        std::cout << "Query executed successfully." << std::endl;
+        // The first page announces the result, later pages only append to it. Copies share the row pages.
+        auto result = m_query->execute(m_queryText, [this](const QueryResult& rows, size_t firstRow) {
+            m_resultOutput = rows;
+            if (firstRow == 0)
+                publishEvent<EventType::QueryExecuted>(QueryExecutedData{rows, true, ""});
+            else
+                publishEvent<EventType::QueryRowsAppended>(QueryRowsAppendedData{rows, firstRow});
+        });
+        m_resultOutput = std::move(result);
+        LOG_INFO("Query executed successfully.");
     }
     catch (const std::exception& e)
     {
         std::string errorMsg = std::string("Query execution failed: ") + e.what();
-        publishEvent(EventType::ErrorOccurred, ErrorData{errorMsg, true});
+        publishEvent<EventType::ErrorOccurred>(ErrorData{errorMsg, true});
         m_resultOutput = QueryResult();
-        std::cerr << errorMsg << std::endl;
+        LOG_ERROR(errorMsg);
     }
 }
 
@@ -134,7 +140,7 @@ void LoadTablesCommand::execute()
             throw std::runtime_error("TableManager is not initialized");
         }
 
-        std::cout << "Loading database objects..." << std::endl;
+        LOG_INFO("Loading database objects...");
 
         auto tables = m_tableManager->getTableNames();
         auto views = m_tableManager->getViewNames();
@@ -143,7 +149,7 @@ void LoadTablesCommand::execute()
 
         if (tables.empty() && views.empty() && procedures.empty() && functions.empty())
         {
-            publishEvent(EventType::ErrorOccurred, ErrorData{"No database objects found", false});
+            publishEvent<EventType::ErrorOccurred>(ErrorData{"No database objects found", false});
         }
         else
         {
@@ -152,14 +158,14 @@ void LoadTablesCommand::execute()
             m_procedureNames = procedures;
             m_functionNames = functions;
 
-            publishEvent(EventType::TablesLoaded, TablesLoadedData{tables, views, procedures, functions, true});
+            publishEvent<EventType::TablesLoaded>(TablesLoadedData{tables, views, procedures, functions, true});
         }
     }
     catch (const std::exception& e)
     {
         std::string error = "Failed to load database objects: " + std::string(e.what());
-        std::cerr << error << std::endl;
-        publishEvent(EventType::ErrorOccurred, ErrorData{error, true});
+        LOG_ERROR(error);
+        publishEvent<EventType::ErrorOccurred>(ErrorData{error, true});
     }
 }
 
@@ -175,11 +181,11 @@ void ExportQueryResultCommand::execute()
         std::string filename = "exports/query_result_" + std::to_string(std::time(nullptr)) + ".csv";
         std::filesystem::create_directories("exports");
         QueryExporter::exportToCSV(m_result, filename);
-        publishEvent(EventType::ExportCompleted, ErrorData{"Saved to " + filename, false});
+        publishEvent<EventType::ExportCompleted>(ErrorData{"Saved to " + filename, false});
     }
     catch (const std::exception& e)
     {
-        publishEvent(EventType::ExportFailed, ErrorData{"Failed to save CSV: " + std::string(e.what()), true});
+        publishEvent<EventType::ExportFailed>(ErrorData{"Failed to save CSV: " + std::string(e.what()), true});
     }
 }
 
@@ -194,7 +200,7 @@ DisconnectCommand::DisconnectCommand(std::unique_ptr<DatabaseManager>& dbManager
 
 void DisconnectCommand::execute()
 {
-    std::cout << "Executing DisconnectCommand..." << std::endl;
+    LOG_INFO("Executing DisconnectCommand...");
 
     auto& latestTableResult = m_guiManager.getLatestTableResult();
     auto& latestQueryResult = m_guiManager.getLatestQueryResult();
@@ -205,6 +211,7 @@ void DisconnectCommand::execute()
     latestQueryResult.data = QueryResult();
 
     m_guiManager.getQueryPanel()->setObjectsVisibility(false);
+    m_guiManager.getERDiagram()->saveLayout();
     m_guiManager.getQueryPanel()->setERDiagramVisibility(false); 
     m_guiManager.getERDiagram()->setVisible(false);              
     m_guiManager.getQueryPanel()->clearQuery();
@@ -215,8 +222,8 @@ void DisconnectCommand::execute()
 
     m_guiManager.setConnected(false);
 
-    publishEvent(EventType::ServerDisconnected, std::any());
-    std::cout << "Disconnect complete, all states cleared" << std::endl;
+    publishEvent<EventType::ServerDisconnected>();
+    LOG_INFO("Disconnect complete, all states cleared");
 }
 
 ClearStateCommand::ClearStateCommand(LatestTableResult& tableResult, LatestQueryResult& queryResult, QueryPanel& queryPanel)
@@ -228,7 +235,7 @@ ClearStateCommand::ClearStateCommand(LatestTableResult& tableResult, LatestQuery
 
 void ClearStateCommand::execute()
 {
-    std::cout << "Executing ClearStateCommand..." << std::endl;
+    LOG_DEBUG("Executing ClearStateCommand...");
 
     m_tableResult.tableNames.clear();
     m_tableResult.isVisible = false;
@@ -236,5 +243,5 @@ void ClearStateCommand::execute()
     m_queryResult.data = QueryResult();
     m_queryPanel.clearQuery();
 
-    std::cout << "State cleared" << std::endl;
+    LOG_DEBUG("State cleared");
 }
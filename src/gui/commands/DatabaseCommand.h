@@ -42,10 +42,10 @@ public:
     virtual void execute() = 0;
 
 protected:
-    template <typename T>
-    void publishEvent(EventType type, T data)
+    template <EventType Type>
+    void publishEvent(const EventBus::Payload<Type>& data = {})
     {
-        EventBus::getInstance().publish(type, std::any(std::move(data)));
+        EventBus::getInstance().publish<Type>(data);
     }
 };
 
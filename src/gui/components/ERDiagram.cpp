@@ -1,9 +1,11 @@
 #include "ERDiagram.h"
 
-#include "diagram/RelationshipRenderer.h"
 #include "diagram/TableRenderer.h"
+#include "TextLayoutCache.h"
+#include "../include/raygui.h"
+#include "../../core/logging/Logger.h"
 
-#include <iostream>
+#include <algorithm>
 
 ERDiagram::ERDiagram(float x, float y, float width, float height)
     : bounds({x, y, width, height})
@@ -15,29 +17,60 @@ void ERDiagram::render()
 {
     if (!isVisible)
     {
-        std::cout << "ERDiagram::render called but diagram is not visible" << std::endl;
+        LOG_TRACE("ERDiagram::render called but diagram is not visible");
         return;
     }
 
-    std::cout << "Rendering ER Diagram with " << tables.size() << " tables and " << relationships.size() << " relationships"
-              << std::endl;
+    LOG_TRACE("Rendering ER Diagram with " << tables.size() << " tables and " << relationships.size() << " relationships");
 
-    DrawRectangleRec(bounds, RAYWHITE);
-    DrawRectangleLinesEx(bounds, 1, Color{200, 200, 200, 255});
+    // Every zoom step produces new widths and font sizes, the old truncations would never be hit again
+    if (zoom != layoutZoom)
+    {
+        TextLayoutCache::clear();
+        layoutZoom = zoom;
+    }
+
+    applyLayout();
+    refreshIndex();
+
+    // Content (including dragged positions), pan and zoom make up the key, an idle diagram is a single texture blit
+    bool arranging = layout.isRunning();
+    uint64_t state = RenderCache::combine(RenderCache::combine(RenderCache::combine(contentVersion, zoom), pan.x), pan.y);
+    state = RenderCache::combine(state, static_cast<uint64_t>(arranging));
+
+    if (cache.begin(bounds, state, RAYWHITE))
+    {
+        DrawRectangleLinesEx(bounds, 1, Color{200, 200, 200, 255});
 
-    BeginScissorMode(bounds.x, bounds.y, bounds.width, bounds.height);
+        Rectangle visible = visibleArea();
+        Diagram::DetailLevel level = Diagram::detailLevel(zoom);
+        renderRelationships(visible, level);
+        renderTables(visible, level);
 
-    renderRelationships();
+        char zoomText[64];
+        snprintf(zoomText, sizeof(zoomText), "Zoom: %.0f%% (Mouse Wheel to zoom)", zoom * 100);
+        DrawText(zoomText, bounds.x + 10, bounds.y + 10, 16, DARKGRAY);
+        DrawText("Middle Mouse Button to pan", bounds.x + 10, bounds.y + 30, 16, DARKGRAY);
+        DrawText("Left Mouse Button to drag tables", bounds.x + 10, bounds.y + 50, 16, DARKGRAY);
+        float statusY = bounds.y + 70;
+        if (!focusTable.empty())
+        {
+            std::string focusText = "Showing the neighbourhood of " + focusTable + ", click a table to add its neighbours";
+            DrawText(focusText.c_str(), bounds.x + 10, statusY, 16, DARKBLUE);
+            statusY += 20;
+        }
+        if (arranging)
+            DrawText("Arranging tables...", bounds.x + 10, statusY, 16, DARKGRAY);
 
-    renderTables();
+        cache.end();
+    }
 
-    EndScissorMode();
+    cache.draw();
 
-    char zoomText[64];
-    snprintf(zoomText, sizeof(zoomText), "Zoom: %.0f%% (Mouse Wheel to zoom)", zoom * 100);
-    DrawText(zoomText, bounds.x + 10, bounds.y + 10, 16, DARKGRAY);
-    DrawText("Middle Mouse Button to pan", bounds.x + 10, bounds.y + 30, 16, DARKGRAY);
-    DrawText("Left Mouse Button to drag tables", bounds.x + 10, bounds.y + 50, 16, DARKGRAY);
+    // Last, the callback replaces everything this diagram holds
+    if (!focusTable.empty() && GuiButton(Rectangle{bounds.x + bounds.width - 150, bounds.y + 10, 140, 30}, "Whole schema") &&
+        onShowAll)
+        onShowAll();
 }
 
 void ERDiagram::update()
@@ -47,23 +80,121 @@ void ERDiagram::update()
 
     interactionHandler->handleZooming(zoom);
     interactionHandler->handlePanning(pan, isPanning);
-    interactionHandler->handleTableDragging(tables, pan, zoom);
+
+    applyLayout();
+    refreshIndex();
+    if (interactionHandler->handleTableDragging(tables, spatialIndex, pan, zoom))
+    {
+        // A table placed by hand wins over whatever the layout would still move it to
+        if (layout.isRunning())
+            layout.cancel();
+        movedTables.push_back(static_cast<uint32_t>(interactionHandler->getDraggedTable()));
+        contentVersion++;
+    }
+
+    int clicked = interactionHandler->takeClickedTable();
+    if (clicked >= 0 && !focusTable.empty() && onTableClick)
+    {
+        // The callback may add tables, which can move the one clicked
+        std::string name = tables[clicked].name;
+        onTableClick(name);
+    }
+}
+
+void ERDiagram::applyLayout()
+{
+    if (!layout.takePositions(layoutPositions) || layoutPositions.size() != tables.size())
+        return;
+
+    for (size_t i = 0; i < tables.size(); ++i)
+        tables[i].position = layoutPositions[i];
+    edgesStale = true;
+    contentVersion++;
 }
 
-void ERDiagram::renderTables()
+void ERDiagram::renderTables(Rectangle visible, Diagram::DetailLevel level)
 {
-    for (const auto& [name, table] : tables)
-        TableRenderer::render(table, bounds, pan, zoom);
+    spatialIndex.queryTables(visible, visibleIds);
+    for (uint32_t id : visibleIds)
+        TableRenderer::render(tables[id], bounds, pan, zoom, level);
 }
 
-void ERDiagram::renderRelationships()
+void ERDiagram::renderRelationships(Rectangle visible, Diagram::DetailLevel level)
 {
+    spatialIndex.queryEdges(visible, visibleIds);
+
+    // Curves stay in diagram coordinates, pan and zoom only change the transform they are drawn with
+    cache.beginTransform(Vector2{bounds.x + pan.x, bounds.y + pan.y}, zoom);
+    for (uint32_t id : visibleIds)
+        RelationshipRenderer::render(curves[id], zoom, level);
+    cache.endTransform();
+}
+
+void ERDiagram::refreshIndex()
+{
+    if (indexedVersion == contentVersion)
+        return;
+
+    if (edgesStale)
+    {
+        resolveEdges();
+    }
+    else
+    {
+        for (uint32_t table : movedTables)
+        {
+            for (uint32_t id : tableEdges[table])
+                buildCurve(id);
+        }
+    }
+    movedTables.clear();
+
+    std::vector<Rectangle> edgeBounds;
+    edgeBounds.reserve(curves.size());
+    for (const auto& curve : curves)
+        edgeBounds.push_back(curve.bounds);
+
+    spatialIndex.build(tables, edgeBounds);
+    indexedVersion = contentVersion;
+}
+
+void ERDiagram::resolveEdges()
+{
+    edges.clear();
+    tableEdges.assign(tables.size(), {});
+
     for (const auto& rel : relationships)
     {
-        const auto& fromTable = tables[rel.fromTable];
-        const auto& toTable = tables[rel.toTable];
-        RelationshipRenderer::render(fromTable, toTable, rel.fromColumn, rel.toColumn, bounds, pan, zoom);
+        auto from = tableIds.find(rel.fromTable);
+        auto to = tableIds.find(rel.toTable);
+        if (from == tableIds.end() || to == tableIds.end())
+            continue;
+
+        uint32_t id = static_cast<uint32_t>(edges.size());
+        edges.push_back({from->second, to->second, RelationshipRenderer::columnRow(tables[from->second], rel.fromColumn),
+                         RelationshipRenderer::columnRow(tables[to->second], rel.toColumn)});
+        tableEdges[from->second].push_back(id);
+        if (to->second != from->second)
+            tableEdges[to->second].push_back(id);
     }
+
+    curves.resize(edges.size());
+    for (uint32_t id = 0; id < edges.size(); ++id)
+        buildCurve(id);
+
+    edgesStale = false;
+}
+
+void ERDiagram::buildCurve(uint32_t edge)
+{
+    const Edge& e = edges[edge];
+    RelationshipRenderer::buildCurve(tables[e.from], e.fromRow, tables[e.to], e.toRow, curves[edge]);
+}
+
+Rectangle ERDiagram::visibleArea() const
+{
+    // Inverse of the screen mapping bounds + position * zoom + pan
+    return Rectangle{-pan.x / zoom, -pan.y / zoom, bounds.width / zoom, bounds.height / zoom};
 }
 
 void ERDiagram::addTable(const std::string& tableName, const std::vector<TableColumn>& columns)
@@ -72,6 +203,18 @@ void ERDiagram::addTable(const std::string& tableName, const std::vector<TableCo
     node.name = tableName;
     node.columns = columns;
 
+    for (uint32_t row = 0; row < node.columns.size(); ++row)
+        node.columnRows.emplace(node.columns[row].name, row);
+
+    for (auto& column : node.columns)
+    {
+        column.label = column.name;
+        if (column.isPrimaryKey)
+            column.label = "[PK] " + column.label;
+        if (column.isForeignKey)
+            column.label = "[FK] " + column.label;
+    }
+
     float width = MIN_TABLE_WIDTH * 1.2f; 
     float height = Diagram::TABLE_HEADER_HEIGHT + columns.size() * Diagram::ROW_HEIGHT;
 
@@ -82,39 +225,141 @@ void ERDiagram::addTable(const std::string& tableName, const std::vector<TableCo
         static_cast<float>(tables.size()) * 70           
     };
 
-    tables[tableName] = node;
+    auto existing = tableIds.find(tableName);
+    if (existing != tableIds.end())
+    {
+        tables[existing->second] = std::move(node);
+    }
+    else
+    {
+        tableIds[tableName] = static_cast<uint32_t>(tables.size());
+        tables.push_back(std::move(node));
+    }
+    edgesStale = true;
+    contentVersion++;
 
     for (const auto& column : columns)
     {
         if (column.isForeignKey && !column.referencedTable.empty())
             relationships.push_back({tableName, column.name, column.referencedTable, column.referencedColumn});
     }
+}
+
+void ERDiagram::addTables(const SchemaSnapshot& schema)
+{
+    for (const auto& table : schema.tables)
+    {
+        std::vector<TableColumn> columns;
+        columns.reserve(table.columns.size());
+        for (const auto& column : table.columns)
+        {
+            columns.push_back(
+                {column.name, column.type, column.isPrimaryKey, column.isForeignKey, column.referencedTable, column.referencedColumn,
+                 ""});
+        }
+        addTable(table.name, columns);
+    }
+}
+
+void ERDiagram::layoutTables()
+{
+    DiagramLayout::Graph graph;
+    graph.sizes.reserve(tables.size());
+    for (const auto& table : tables)
+        graph.sizes.push_back(table.size);
+
+    for (const auto& rel : relationships)
+    {
+        auto from = tableIds.find(rel.fromTable);
+        auto to = tableIds.find(rel.toTable);
+        if (from != tableIds.end() && to != tableIds.end())
+            graph.edges.push_back({from->second, to->second});
+    }
 
-    autoLayoutTables();
+    LOG_INFO("Arranging " << graph.sizes.size() << " tables with " << graph.edges.size() << " relationships");
+    layout.start(std::move(graph));
 }
 
-void ERDiagram::autoLayoutTables()
+void ERDiagram::placeTables(const DiagramStore::Saved& saved)
 {
-    const float SPACING_X = MIN_TABLE_WIDTH * 1.5f; 
-    const float SPACING_Y = 250;                    
-    const int TABLES_PER_ROW = 3;
+    std::unordered_map<std::string, Vector2> positions;
+    for (const auto& table : saved.tables)
+        positions.emplace(table.name, table.position);
 
-    int i = 0;
-    for (auto& [name, table] : tables)
+    float bottom = 0.0f;
+    std::vector<TableNode*> unplaced;
+    for (auto& table : tables)
     {
-        int row = i / TABLES_PER_ROW;
-        int col = i % TABLES_PER_ROW;
+        auto it = positions.find(table.name);
+        if (it == positions.end())
+        {
+            unplaced.push_back(&table);
+            continue;
+        }
+        table.position = it->second;
+        bottom = std::max(bottom, table.position.y + table.size.y);
+    }
 
-        table.position = {col * SPACING_X + 50, row * SPACING_Y + 50};
+    if (unplaced.size() == tables.size())
+    {
+        layoutTables();
+        return;
+    }
 
-        i++;
+    // New tables keep the hand-made arrangement intact by going in rows underneath it
+    const int TABLES_PER_ROW = 8;
+    for (size_t i = 0; i < unplaced.size(); ++i)
+    {
+        unplaced[i]->position = {(i % TABLES_PER_ROW) * (MIN_TABLE_WIDTH * 1.5f) + 50,
+                                 bottom + 150 + (i / TABLES_PER_ROW) * 400.0f};
     }
+
+    layout.cancel();
+    zoom = saved.zoom;
+    pan = saved.pan;
+    edgesStale = true;
+    contentVersion++;
+    LOG_INFO("Restored " << tables.size() - unplaced.size() << " table positions, " << unplaced.size() << " tables are new");
+}
+
+void ERDiagram::setSource(const std::string& path, const std::string& schemaFingerprint)
+{
+    storePath = path;
+    fingerprint = schemaFingerprint;
+}
+
+bool ERDiagram::saveLayout()
+{
+    if (storePath.empty() || tables.empty())
+        return false;
+
+    // Positions a running layout has published already are what the user sees, save those
+    applyLayout();
+
+    DiagramStore::Saved saved;
+    saved.fingerprint = fingerprint;
+    saved.tables = tables;
+    saved.zoom = zoom;
+    saved.pan = pan;
+    return DiagramStore::save(storePath, saved);
 }
 
 void ERDiagram::clear()
 {
+    layout.cancel();
+    storePath.clear();
+    fingerprint.clear();
+    focusTable.clear();
     tables.clear();
+    tableIds.clear();
     relationships.clear();
+    edges.clear();
+    curves.clear();
+    tableEdges.clear();
+    movedTables.clear();
+    edgesStale = true;
+    interactionHandler->cancelDrag();
+    contentVersion++;
     zoom = 1.0f;
     pan = {0, 0};
 }
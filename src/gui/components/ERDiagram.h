@@ -1,7 +1,14 @@
 #pragma once
 
 #include "diagram/DiagramInteractionHandler.h"
+#include "diagram/DiagramLayout.h"
+#include "diagram/DiagramStore.h"
+#include "diagram/RelationshipRenderer.h"
+#include "diagram/DiagramSpatialIndex.h"
 #include "diagram/DiagramTypes.h"
+#include "RenderCache.h"
+#include "../../core/database/SchemaSnapshot.h"
+#include <functional>
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
@@ -13,6 +20,8 @@ public:
     using TableColumn = Diagram::TableColumn;
     using TableNode = Diagram::TableNode;
     using Relationship = Diagram::Relationship;
+    using TableClickCallback = std::function<void(const std::string&)>;
+    using ShowAllCallback = std::function<void()>;
 
 public:
     ERDiagram(float x, float y, float width, float height);
@@ -21,25 +30,86 @@ public:
     void render();
     void update();
     void addTable(const std::string& tableName, const std::vector<TableColumn>& columns);
+    void addTables(const SchemaSnapshot& schema);
+    bool hasTable(const std::string& tableName) const { return tableIds.count(tableName) > 0; }
+    // Arranges all tables along their relationships in the background, call once after adding them
+    void layoutTables();
+    // Puts tables where a saved layout had them and takes over its view, tables it does not know go below.
+    // Falls back to layoutTables() when none of the tables were saved.
+    void placeTables(const DiagramStore::Saved& saved);
     void clear();
 
+    // Where the layout is saved and which schema version the tables came from
+    void setSource(const std::string& storePath, const std::string& fingerprint);
+    const std::string& getStorePath() const { return storePath; }
+    const std::string& getFingerprint() const { return fingerprint; }
+    bool isEmpty() const { return tables.empty(); }
+    bool saveLayout();
+
+    // A focused diagram holds only the neighbourhood of one table. Clicking a table asks for its neighbours
+    // through the click callback, the whole schema button through the show all callback.
+    void setFocus(const std::string& tableName)
+    {
+        focusTable = tableName;
+        contentVersion++;
+    }
+    const std::string& getFocus() const { return focusTable; }
+    void setTableClickCallback(TableClickCallback callback) { onTableClick = std::move(callback); }
+    void setShowAllCallback(ShowAllCallback callback) { onShowAll = std::move(callback); }
+
+public:
+    static constexpr size_t FOCUS_THRESHOLD = 100; // Schemas with more tables open focused on the selected table
+    static constexpr int FOCUS_HOPS = 2;
+
 public:
     void setVisible(bool visible) { isVisible = visible; }
     bool getVisible() const { return isVisible; }
 
 private:
-    void renderTables();
-    void renderRelationships();
-    void autoLayoutTables();
+    void renderTables(Rectangle visible, Diagram::DetailLevel level);
+    void renderRelationships(Rectangle visible, Diagram::DetailLevel level);
+    void applyLayout();
+    void refreshIndex();
+    void resolveEdges();
+    void buildCurve(uint32_t edge);
+    Rectangle visibleArea() const;
 
 private:
     Rectangle bounds;
-    std::unordered_map<std::string, TableNode> tables;
+    std::vector<TableNode> tables; // Drawing order, later tables on top
+    std::unordered_map<std::string, uint32_t> tableIds;
     std::vector<Relationship> relationships;
+
+    // Relationships resolved to table ids and column rows; edges to tables not loaded are skipped
+    struct Edge
+    {
+        uint32_t from;
+        uint32_t to;
+        int fromRow;
+        int toRow;
+    };
+    std::vector<Edge> edges;
+    std::vector<RelationshipRenderer::Curve> curves; // Per edge
+    std::vector<std::vector<uint32_t>> tableEdges;   // Edge ids per table id
+    std::vector<uint32_t> movedTables;               // Tables moved by hand since the last refresh
+    bool edgesStale = true;                          // Tables or relationships changed, or every table moved
+    DiagramSpatialIndex spatialIndex;
+    uint64_t indexedVersion = ~0ull;
+    std::vector<uint32_t> visibleIds; // Scratch for index queries
     float zoom = 1.0f;
+    float layoutZoom = 1.0f;
     Vector2 pan = {0, 0};
     bool isPanning = false;
     bool isVisible = false;
+    uint64_t contentVersion = 0; // Changes with tables, relationships and table positions
+    RenderCache cache;
+    DiagramLayout layout;
+    std::vector<Vector2> layoutPositions;
+    std::string storePath;
+    std::string fingerprint;
+    std::string focusTable;
+    TableClickCallback onTableClick;
+    ShowAllCallback onShowAll;
 
 private:
     std::unique_ptr<DiagramInteractionHandler> interactionHandler;
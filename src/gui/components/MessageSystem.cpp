@@ -3,6 +3,7 @@
 #include "../core/EventData.h"
 #include "../core/EventType.h"
 
+#include <algorithm>
 #include <memory>
 
 MessageSystem::MessageSystem(int screenHeight) noexcept
@@ -24,55 +25,39 @@ MessageSystem::~MessageSystem()
 {
     auto& bus = EventBus::getInstance();
 
-    for (auto id : subscriptionIds)
-        bus.unsubscribe(EventType::ErrorOccurred, id);
+    for (const auto& [type, id] : subscriptionIds)
+        bus.unsubscribe(type, id);
 }
 
 void MessageSystem::setupSubscriptions()
 {
     auto& bus = EventBus::getInstance();
 
-    subscriptionIds.push_back(bus.subscribe(EventType::ErrorOccurred, [this](const auto& data) {
-        auto* errorData = std::any_cast<ErrorData>(&data);
-
-        if (errorData)
-            showMessage(errorData->message, true);
+    subscriptionIds.emplace_back(EventType::ErrorOccurred, bus.subscribe<EventType::ErrorOccurred>([this](const auto& data) {
+        showMessage(data.message, true);
     }));
 
-    subscriptionIds.push_back(bus.subscribe(EventType::ServerConnected, [this](const auto&) {
+    subscriptionIds.emplace_back(EventType::ServerConnected, bus.subscribe<EventType::ServerConnected>([this](const auto&) {
         showMessage("Connected to server", false);
     }));
 
-    subscriptionIds.push_back(bus.subscribe(EventType::DatabaseConnected, [this](const auto& data) {
-        auto* connData = std::any_cast<DatabaseConnectedData>(&data);
-
-        if (connData)
-            showMessage("Connected to database: " + connData->databaseName, false);
+    subscriptionIds.emplace_back(EventType::DatabaseConnected, bus.subscribe<EventType::DatabaseConnected>([this](const auto& data) {
+        showMessage("Connected to database: " + data.databaseName, false);
     }));
 
-    subscriptionIds.push_back(bus.subscribe(EventType::QueryExecuted, [this](const auto& data) {
-        auto* queryData = std::any_cast<QueryExecutedData>(&data);
-        if (queryData)
-        {
-            if (queryData->success)
-                showMessage("Query executed successfully", false);
-            else
-                showMessage(queryData->error, true);
-        }
+    subscriptionIds.emplace_back(EventType::QueryExecuted, bus.subscribe<EventType::QueryExecuted>([this](const auto& data) {
+        if (data.success)
+            showMessage("Query executed successfully", false);
+        else
+            showMessage(data.error, true);
     }));
 
-    subscriptionIds.push_back(bus.subscribe(EventType::ExportCompleted, [this](const auto& data) {
-        auto* exportData = std::any_cast<ErrorData>(&data);
-
-        if (exportData)
-            showMessage(exportData->message, exportData->isError);
+    subscriptionIds.emplace_back(EventType::ExportCompleted, bus.subscribe<EventType::ExportCompleted>([this](const auto& data) {
+        showMessage(data.message, data.isError);
     }));
 
-    subscriptionIds.push_back(bus.subscribe(EventType::ImportCompleted, [this](const auto& data) {
-        auto* importData = std::any_cast<ErrorData>(&data);
-
-        if (importData)
-            showMessage(importData->message, importData->isError);
+    subscriptionIds.emplace_back(EventType::ImportCompleted, bus.subscribe<EventType::ImportCompleted>([this](const auto& data) {
+        showMessage(data.message, data.isError);
     }));
 }
 
@@ -107,7 +92,7 @@ void MessageSystem::render(float deltaTime)
 
         DrawText(currentMessage.text.c_str(), textX, textY, 18, textColor);
 
-        currentMessage.timeRemaining -= deltaTime;
+        currentMessage.timeRemaining -= std::min(deltaTime, MAX_FRAME_STEP);
     }
 }
 
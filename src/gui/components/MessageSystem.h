@@ -16,6 +16,7 @@ public:
     void showMessage(const std::string& text, bool isError, float duration = 3.0f);
     void render(float deltaTime);
     void clear();
+    bool isAnimating() const { return currentMessage.timeRemaining > 0.0f; }
 
 private:
     struct Message
@@ -31,7 +32,8 @@ private:
 private:
     Message currentMessage;
     Rectangle messageBox;
-    std::vector<EventBus::SubscriberId> subscriptionIds;
+    std::vector<std::pair<EventType, EventBus::SubscriberId>> subscriptionIds;
 
     static constexpr float FADE_DURATION = 0.5f;
+    static constexpr float MAX_FRAME_STEP = 0.1f; // The frame after an idle wait reports the whole wait
 };
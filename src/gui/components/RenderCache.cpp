@@ -0,0 +1,102 @@
+#include "RenderCache.h"
+
+#include <cmath>
+#include <cstring>
+
+RenderCache::~RenderCache()
+{
+    // The window may already be closed when panels are destroyed, its context took the texture with it
+    if (target.id != 0 && IsWindowReady())
+        UnloadRenderTexture(target);
+}
+
+bool RenderCache::begin(Rectangle bounds, uint64_t stateKey, Color background)
+{
+    int width = static_cast<int>(std::ceil(bounds.width));
+    int height = static_cast<int>(std::ceil(bounds.height));
+    if (width <= 0 || height <= 0)
+        return false;
+
+    if (target.id == 0 || target.texture.width != width || target.texture.height != height)
+    {
+        if (target.id != 0)
+            UnloadRenderTexture(target);
+
+        target = LoadRenderTexture(width, height);
+        valid = false;
+    }
+
+    bool moved = area.x != bounds.x || area.y != bounds.y;
+    area = bounds;
+
+    if (valid && !moved && key == stateKey)
+        return false;
+
+    key = stateKey;
+
+    BeginTextureMode(target);
+    ClearBackground(background);
+
+    BeginMode2D(screenCamera(bounds));
+
+    return true;
+}
+
+void RenderCache::beginTransform(Vector2 offset, float zoom)
+{
+    // BeginMode2D replaces the current camera, so the texture origin is folded into this one
+    Camera2D camera = {};
+    camera.offset = Vector2{offset.x - area.x, offset.y - area.y};
+    camera.zoom = zoom;
+
+    EndMode2D();
+    BeginMode2D(camera);
+}
+
+void RenderCache::endTransform()
+{
+    EndMode2D();
+    BeginMode2D(screenCamera(area));
+}
+
+void RenderCache::end()
+{
+    EndMode2D();
+    EndTextureMode();
+    valid = true;
+}
+
+void RenderCache::draw() const
+{
+    if (target.id == 0)
+        return;
+
+    // Render textures are stored upside down
+    Rectangle source = {0, 0, static_cast<float>(target.texture.width), -static_cast<float>(target.texture.height)};
+    DrawTextureRec(target.texture, source, Vector2{area.x, area.y}, WHITE);
+}
+
+Camera2D RenderCache::screenCamera(Rectangle bounds)
+{
+    Camera2D camera = {};
+    camera.offset = Vector2{-bounds.x, -bounds.y};
+    camera.zoom = 1.0f;
+    return camera;
+}
+
+uint64_t RenderCache::combine(uint64_t seed, uint64_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+uint64_t RenderCache::combine(uint64_t seed, float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return combine(seed, static_cast<uint64_t>(bits));
+}
+
+uint64_t RenderCache::combine(uint64_t seed, Rectangle value)
+{
+    return combine(combine(combine(combine(seed, value.x), value.y), value.width), value.height);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include <raylib.h>
+
+// Keeps the pixels of a panel in a render texture and redraws them only when the owner's state key
+// changes; every other frame costs a single textured quad. Drawing between begin() and end() keeps
+// using screen coordinates. The texture already clips to the bounds, and scissor mode must not be
+// used inside since it is not translated.
+class RenderCache
+{
+public:
+    RenderCache() = default;
+    ~RenderCache();
+
+    RenderCache(const RenderCache&) = delete;
+    RenderCache& operator=(const RenderCache&) = delete;
+
+public:
+    // Returns true when the cached pixels are stale, the caller then draws and calls end()
+    bool begin(Rectangle bounds, uint64_t stateKey, Color background);
+    void end();
+    void draw() const;
+    void invalidate() { valid = false; }
+
+    // Between begin() and end(): draws in coordinates scaled by zoom and then moved by offset (in screen space),
+    // applied by the GPU instead of per vertex
+    void beginTransform(Vector2 offset, float zoom);
+    void endTransform();
+
+    static uint64_t combine(uint64_t seed, uint64_t value);
+    static uint64_t combine(uint64_t seed, float value);
+    static uint64_t combine(uint64_t seed, Rectangle value);
+
+private:
+    RenderTexture2D target{};
+    Rectangle area{};
+    uint64_t key = 0;
+    bool valid = false;
+
+    static Camera2D screenCamera(Rectangle bounds);
+};
@@ -0,0 +1,270 @@
+#include "ResultGrid.h"
+#include "TextMetrics.h"
+
+#include <algorithm>
+
+void ResultGrid::render(Rectangle bounds, const QueryResult& result, const ResultView& view)
+{
+    if (!layoutValid || layoutColumns != result.columns.size() || layoutRows > result.rows.size())
+        buildLayout(result);
+    else if (layoutRows < result.rows.size())
+        extendLayout(result);
+
+    // Appended pages only add offsets at the end, anything else (sort, filter, new result) starts over
+    if (offsetsGeneration != layoutGeneration || offsetsViewVersion != view.getVersion())
+    {
+        size_t firstNew = 0;
+        bool appended = offsetsGeneration == layoutGeneration && view.extends(offsetsViewVersion, firstNew);
+        buildRowOffsets(view, appended ? firstNew : 0);
+    }
+
+    handleScrolling(bounds);
+    handleHeaderClick(bounds);
+
+    uint64_t state = RenderCache::combine(RenderCache::combine(layoutVersion, view.getVersion()), scrollX);
+    state = RenderCache::combine(RenderCache::combine(state, scrollY), bounds);
+    if (cache.begin(bounds, state, RAYWHITE))
+    {
+        drawGrid(bounds, result, view);
+        cache.end();
+    }
+
+    cache.draw();
+}
+
+void ResultGrid::handleHeaderClick(Rectangle bounds)
+{
+    clickedColumn = -1;
+    if (!IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        return;
+
+    Vector2 mouse = GetMousePosition();
+    Rectangle header = {bounds.x, bounds.y + PADDING, bounds.width - SCROLLBAR_SIZE, LINE_HEIGHT};
+    if (!CheckCollisionPointRec(mouse, header))
+        return;
+
+    float position = mouse.x - bounds.x - PADDING + scrollX;
+    if (position < 0.0f || position >= columnOffsets.back())
+        return;
+
+    clickedColumn = static_cast<int>(findFirstVisible(columnOffsets, position));
+}
+
+void ResultGrid::drawGrid(Rectangle bounds, const QueryResult& result, const ResultView& view)
+{
+    float headerY = bounds.y + PADDING;
+    float rowsTop = headerY + LINE_HEIGHT;
+    float originX = bounds.x + PADDING - scrollX;
+    float viewWidth = bounds.width - SCROLLBAR_SIZE;
+    float viewBottom = bounds.y + bounds.height - SCROLLBAR_SIZE;
+
+    size_t firstColumn = findFirstVisible(columnOffsets, scrollX - PADDING);
+    size_t lastColumn = firstColumn;
+    while (lastColumn < result.columns.size() && originX + columnOffsets[lastColumn] < bounds.x + viewWidth)
+        lastColumn++;
+
+    size_t firstRow = findFirstVisible(rowOffsets, scrollY);
+    size_t lastRow = firstRow;
+    while (lastRow < view.size() && rowsTop + rowOffsets[lastRow] - scrollY < viewBottom)
+        lastRow++;
+
+    float left = originX + columnOffsets[firstColumn];
+    float right = std::min(originX + columnOffsets[lastColumn], bounds.x + viewWidth);
+    Font font = GetFontDefault();
+
+    // All quads go out before any text so the batch only switches between the shape and font textures
+    // once per pass instead of once per cell. The cache texture clips to bounds; the header and scrollbar
+    // strips are painted over whatever scrolled underneath them.
+    float bodyBottom = std::min(rowsTop + rowOffsets[lastRow] - scrollY, viewBottom);
+    for (size_t row = firstRow; row <= lastRow; ++row)
+        DrawRectangleRec(Rectangle{left, rowsTop + rowOffsets[row] - scrollY, right - left, 1.0f}, BLACK);
+    for (size_t col = firstColumn; col <= lastColumn; ++col)
+        DrawRectangleRec(Rectangle{originX + columnOffsets[col], rowsTop, 1.0f, bodyBottom - rowsTop}, BLACK);
+
+    for (size_t row = firstRow; row < lastRow; ++row)
+    {
+        float y = rowsTop + rowOffsets[row] - scrollY;
+        const auto& cells = result.rows[view.rowAt(row)];
+
+        for (size_t col = firstColumn; col < lastColumn && col < cells.size(); ++col)
+            drawCellText(font, cells[col], originX + columnOffsets[col], y, columnOffsets[col + 1] - columnOffsets[col]);
+    }
+
+    DrawRectangleRec(Rectangle{bounds.x, viewBottom, bounds.width, SCROLLBAR_SIZE}, RAYWHITE);
+    DrawRectangleRec(Rectangle{bounds.x + viewWidth, bounds.y, SCROLLBAR_SIZE, bounds.height}, RAYWHITE);
+    DrawRectangleRec(Rectangle{bounds.x, bounds.y, bounds.width, rowsTop - bounds.y}, RAYWHITE);
+
+    DrawRectangleRec(Rectangle{left, headerY, right - left, LINE_HEIGHT}, GRAY);
+    DrawRectangleLinesEx(Rectangle{left, headerY, right - left, LINE_HEIGHT}, 1.0f, BLACK);
+    for (size_t col = firstColumn + 1; col < lastColumn; ++col)
+        DrawRectangleRec(Rectangle{originX + columnOffsets[col], headerY, 1.0f, LINE_HEIGHT}, BLACK);
+
+    for (size_t col = firstColumn; col < lastColumn; ++col)
+    {
+        drawCellText(font, result.columns[col], originX + columnOffsets[col], headerY, columnOffsets[col + 1] - columnOffsets[col]);
+        if (view.getSortColumn() == static_cast<int>(col))
+            drawSortMark(view.getSortOrder(), originX + columnOffsets[col + 1], headerY);
+    }
+
+    drawScrollBars(bounds);
+}
+
+void ResultGrid::resetScroll()
+{
+    scrollX = 0.0f;
+    scrollY = 0.0f;
+}
+
+void ResultGrid::buildLayout(const QueryResult& result)
+{
+    columnWidths.clear();
+    columnWidths.reserve(result.columns.size());
+
+    // Headers keep room for the sort mark so sorting never changes the layout
+    for (const auto& column : result.columns)
+        columnWidths.push_back(TextMetrics::measure(column, FONT_SIZE) + PADDING * 2 + SORT_MARK_WIDTH);
+
+    rowLines.clear();
+    layoutRows = 0;
+    layoutColumns = result.columns.size();
+    sampleStride = 1;
+
+    extendLayout(result);
+    layoutValid = true;
+    layoutGeneration++;
+}
+
+void ResultGrid::extendLayout(const QueryResult& result)
+{
+    // Row heights need every row, widths are taken from an evenly spread sample once the result gets large
+    sampleStride = std::max(sampleStride, result.rows.size() / WIDTH_SAMPLE_ROWS);
+    rowLines.reserve(result.rows.size());
+
+    for (size_t r = layoutRows; r < result.rows.size(); ++r)
+    {
+        const auto& row = result.rows[r];
+        bool sampled = r % sampleStride == 0;
+        size_t lines = 1;
+
+        for (size_t col = 0; col < row.size(); ++col)
+        {
+            lines = std::max(lines, static_cast<size_t>(std::count(row[col].begin(), row[col].end(), '\n')) + 1);
+
+            if (sampled && col < columnWidths.size())
+                columnWidths[col] = std::max(columnWidths[col], TextMetrics::measure(row[col], FONT_SIZE) + PADDING * 2);
+        }
+        rowLines.push_back(static_cast<uint16_t>(std::min<size_t>(lines, UINT16_MAX)));
+    }
+
+    columnOffsets.assign(1, 0.0f);
+    for (int width : columnWidths)
+        columnOffsets.push_back(columnOffsets.back() + width);
+
+    layoutRows = result.rows.size();
+    layoutVersion++;
+}
+
+void ResultGrid::buildRowOffsets(const ResultView& view, size_t from)
+{
+    rowOffsets.resize(view.size() + 1);
+    rowOffsets[0] = 0.0f;
+
+    for (size_t i = from; i < view.size(); ++i)
+    {
+        uint32_t row = view.rowAt(i);
+        float lines = row < rowLines.size() ? rowLines[row] : 1.0f;
+        rowOffsets[i + 1] = rowOffsets[i] + lines * LINE_HEIGHT;
+    }
+
+    offsetsGeneration = layoutGeneration;
+    offsetsViewVersion = view.getVersion();
+}
+
+void ResultGrid::drawSortMark(ResultView::SortOrder order, float right, float headerY)
+{
+    float x = right - PADDING - SORT_MARK_WIDTH / 2.0f;
+    float y = headerY + LINE_HEIGHT / 2.0f;
+
+    if (order == ResultView::SortOrder::ASCENDING)
+        DrawTriangle(Vector2{x, y - 4}, Vector2{x - 4, y + 3}, Vector2{x + 4, y + 3}, BLACK);
+    else if (order == ResultView::SortOrder::DESCENDING)
+        DrawTriangle(Vector2{x - 4, y - 3}, Vector2{x, y + 4}, Vector2{x + 4, y - 3}, BLACK);
+}
+
+void ResultGrid::handleScrolling(Rectangle bounds)
+{
+    float totalWidth = columnOffsets.back();
+    float totalHeight = rowOffsets.back() + LINE_HEIGHT;
+
+    float maxScrollX = std::max(0.0f, totalWidth - bounds.width + PADDING * 2);
+    float maxScrollY = std::max(0.0f, totalHeight - bounds.height + PADDING * 2);
+
+    if (CheckCollisionPointRec(GetMousePosition(), bounds))
+    {
+        float wheel = GetMouseWheelMove();
+
+        if (IsKeyDown(KEY_LEFT_CONTROL))
+            scrollX -= wheel * 20;
+        else
+            scrollY -= wheel * 20;
+    }
+
+    scrollX = std::clamp(scrollX, 0.0f, maxScrollX);
+    scrollY = std::clamp(scrollY, 0.0f, maxScrollY);
+}
+
+void ResultGrid::drawScrollBars(Rectangle bounds)
+{
+    float totalWidth = columnOffsets.back();
+    float totalHeight = rowOffsets.back() + LINE_HEIGHT;
+
+    if (totalWidth > bounds.width)
+    {
+        float scrollBarWidth = std::max(20.0f, (bounds.width / totalWidth) * bounds.width);
+        float scrollBarX = bounds.x + (scrollX / totalWidth) * (bounds.width - scrollBarWidth);
+        DrawRectangle(bounds.x, bounds.y + bounds.height - SCROLLBAR_SIZE, bounds.width, SCROLLBAR_SIZE, Color{235, 235, 235, 255});
+        DrawRectangle(scrollBarX, bounds.y + bounds.height - SCROLLBAR_SIZE, scrollBarWidth, SCROLLBAR_SIZE, Color{180, 180, 180, 255});
+    }
+
+    if (totalHeight > bounds.height)
+    {
+        float scrollBarHeight = std::max(20.0f, (bounds.height / totalHeight) * bounds.height);
+        float scrollBarY = bounds.y + (scrollY / totalHeight) * (bounds.height - scrollBarHeight);
+        DrawRectangle(bounds.x + bounds.width - SCROLLBAR_SIZE, bounds.y, SCROLLBAR_SIZE, bounds.height, Color{235, 235, 235, 255});
+        DrawRectangle(bounds.x + bounds.width - SCROLLBAR_SIZE, scrollBarY, SCROLLBAR_SIZE, scrollBarHeight, Color{180, 180, 180, 255});
+    }
+}
+
+void ResultGrid::drawCellText(const Font& font, std::string_view text, float x, float y, float width)
+{
+    float right = x + width - PADDING;
+    float lineY = y + 2;
+
+    // Lines are walked as views into the cell, glyphs past the right edge are dropped instead of drawn and clipped
+    for (size_t start = 0; start <= text.size(); lineY += LINE_HEIGHT)
+    {
+        size_t end = std::min(text.find('\n', start), text.size());
+        float glyphX = x + PADDING;
+
+        for (size_t pos = start; pos < end;)
+        {
+            int codepoint = TextMetrics::nextCodepoint(text.substr(0, end), pos);
+            float advance = TextMetrics::advance(codepoint, FONT_SIZE);
+            if (glyphX + advance > right)
+                break;
+
+            if (codepoint != ' ' && codepoint != '\t')
+                DrawTextCodepoint(font, codepoint, Vector2{glyphX, lineY}, FONT_SIZE, DARKGRAY);
+            glyphX += advance;
+        }
+
+        start = end + 1;
+    }
+}
+
+size_t ResultGrid::findFirstVisible(const std::vector<float>& offsets, float position)
+{
+    // offsets[i + 1] is the bottom (or right) edge of item i, the first one past the position is visible
+    auto it = std::upper_bound(offsets.begin() + 1, offsets.end(), position);
+    return static_cast<size_t>(it - offsets.begin()) - 1;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../../core/results/ResultView.h"
+#include "../../models/QueryResult.h"
+#include "RenderCache.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <raylib.h>
+
+// Virtualized grid: row and column offsets are built once per result and extended as rows are appended,
+// the visible window of cells is located by binary search and only redrawn when the data or scroll changes.
+// Rows are shown in the order and selection of a ResultView.
+class ResultGrid
+{
+public:
+    void render(Rectangle bounds, const QueryResult& result, const ResultView& view);
+
+    // Column whose header was clicked during the last render, -1 if none
+    int getClickedColumn() const { return clickedColumn; }
+
+    // Measures the result up front so the first frame after a query does not pay for it
+    void prepare(const QueryResult& result) { buildLayout(result); }
+    void invalidate() { layoutValid = false; }
+    void resetScroll();
+
+private:
+    void buildLayout(const QueryResult& result);
+    void extendLayout(const QueryResult& result);
+    void buildRowOffsets(const ResultView& view, size_t from);
+    void handleHeaderClick(Rectangle bounds);
+    void drawGrid(Rectangle bounds, const QueryResult& result, const ResultView& view);
+    void drawSortMark(ResultView::SortOrder order, float right, float headerY);
+    void handleScrolling(Rectangle bounds);
+    void drawScrollBars(Rectangle bounds);
+    void drawCellText(const Font& font, std::string_view text, float x, float y, float width);
+
+    static size_t findFirstVisible(const std::vector<float>& offsets, float position);
+
+private:
+    std::vector<float> rowOffsets;    // Top of each visible row relative to the first one, back() is the total height
+    std::vector<uint16_t> rowLines;   // Line count of each data row in result order
+    std::vector<float> columnOffsets; // Left edge of each column, back() is the total width
+    std::vector<int> columnWidths;
+    size_t sampleStride = 1; // Only every n-th row is measured for column widths on large results
+    size_t layoutRows = 0;
+    size_t layoutColumns = 0;
+    bool layoutValid = false;
+    uint64_t layoutVersion = 0;
+    uint64_t layoutGeneration = 0; // Changes only when the layout is rebuilt from scratch
+    uint64_t offsetsGeneration = ~0ull;
+    uint64_t offsetsViewVersion = ~0ull;
+    int clickedColumn = -1;
+    RenderCache cache;
+
+    float scrollX = 0.0f;
+    float scrollY = 0.0f;
+
+private:
+    static constexpr float LINE_HEIGHT = 20.0f;
+    static constexpr int FONT_SIZE = 18;
+    static constexpr int PADDING = 5;
+    static constexpr float SCROLLBAR_SIZE = 8.0f;
+    static constexpr int SORT_MARK_WIDTH = 12;
+    static constexpr size_t WIDTH_SAMPLE_ROWS = 2000;
+};
@@ -1,6 +1,10 @@
 #include "ScrollableList.h"
 
 #include "IconRenderer.h"
+#include "TextLayoutCache.h"
+#include "TextMetrics.h"
+
+#include <algorithm>
 
 ScrollableList::ScrollableList(const char* title, float x, float y, float width, float height, float itemHeight, float titleY)
     : title(title)
@@ -10,20 +14,60 @@ ScrollableList::ScrollableList(const char* title, float x, float y, float width,
 {
 }
 
-void ScrollableList::render(const std::vector<ListItem>& items)
+void ScrollableList::setItems(std::vector<ListItem> newItems)
+{
+    items = std::move(newItems);
+    itemsVersion++;
+
+    float maxScroll = std::max(0.0f, items.size() * itemHeight - bounds.height);
+    listScroll = std::clamp(listScroll, 0.0f, maxScroll);
+}
+
+void ScrollableList::setSelectedIndex(int index)
+{
+    for (size_t i = 0; i < items.size(); i++)
+        items[i].isSelected = static_cast<int>(i) == index;
+    itemsVersion++;
+}
+
+void ScrollableList::render()
 {
     drawHeader();
-    drawListBackground();
+    DrawRectangleRec(Rectangle{bounds.x + 2, bounds.y + 2, bounds.width, bounds.height}, Color{200, 200, 200, 100});
 
     float contentHeight = items.size() * itemHeight;
     handleScrolling(contentHeight);
+    updateHover();
+
+    // The list only changes with its items, scroll position or hover, every other frame reuses the texture
+    if (cache.begin(bounds, stateKey(contentHeight), RAYWHITE))
+    {
+        drawItems();
+        DrawRectangleLinesEx(bounds, 1, Color{200, 200, 200, 255});
+        drawScrollbar(contentHeight);
+        cache.end();
+    }
+
+    cache.draw();
+
+    if (hoveredItem < 0)
+        return;
+
+    const ListItem& hovered = items[hoveredItem];
+    Rectangle itemRect = itemBounds(hovered, hoveredItem);
+
+    if (actionHovered)
+    {
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && onActionButton)
+            onActionButton(hovered);
+        return;
+    }
 
-    BeginScissorMode(bounds.x, bounds.y, bounds.width - SCROLLBAR_WIDTH, bounds.height);
-    drawItems(items);
-    EndScissorMode();
+    if (labelFor(hoveredItem).truncated)
+        drawTooltip(hovered.text, itemRect);
 
-    DrawRectangleLinesEx(bounds, 1, Color{200, 200, 200, 255});
-    drawScrollbar(contentHeight);
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && onItemClick)
+        onItemClick(hovered);
 }
 
 void ScrollableList::drawHeader()
@@ -31,47 +75,32 @@ void ScrollableList::drawHeader()
     DrawText(title.c_str(), bounds.x, titleY, 18, Color{70, 70, 70, 255});
 }
 
-void ScrollableList::drawListBackground()
+void ScrollableList::drawItems()
 {
-    DrawRectangleRec(Rectangle{bounds.x + 2, bounds.y + 2, bounds.width, bounds.height}, Color{200, 200, 200, 100});
+    if (items.empty() || itemHeight <= 0)
+        return;
 
-    DrawRectangleRec(bounds, RAYWHITE);
-}
+    size_t first = static_cast<size_t>(std::max(0.0f, listScroll / itemHeight));
+    size_t last = std::min(items.size(), static_cast<size_t>((listScroll + bounds.height) / itemHeight) + 1);
 
-void ScrollableList::drawItems(const std::vector<ListItem>& items)
-{
-    for (size_t i = 0; i < items.size(); i++)
+    for (size_t i = first; i < last; i++)
     {
-        float itemY = bounds.y + i * itemHeight - listScroll;
-
-        if (itemY + itemHeight <= bounds.y || itemY >= bounds.y + bounds.height)
-            continue;
-
-        float itemWidth =
-            items[i].hasActionButton ? bounds.width - ACTION_BUTTON_WIDTH - SCROLLBAR_WIDTH : bounds.width - SCROLLBAR_WIDTH;
-
-        Rectangle itemRect = {bounds.x + 1, itemY, itemWidth, itemHeight};
+        Rectangle itemRect = itemBounds(items[i], i);
+        float itemY = itemRect.y;
 
-        bool isHovered = CheckCollisionPointRec(GetMousePosition(), itemRect);
-        drawItem(items[i], itemRect, isHovered);
+        bool isHovered = hoveredItem == static_cast<int>(i);
+        drawItem(i, itemRect, isHovered && !actionHovered);
 
         if (items[i].hasActionButton)
         {
-            EndScissorMode();
-
             Rectangle actionBtn = {itemRect.x + itemRect.width, itemY, ACTION_BUTTON_WIDTH, itemHeight};
 
-            bool isActionHovered = CheckCollisionPointRec(GetMousePosition(), actionBtn);
+            bool isActionHovered = isHovered && actionHovered;
             Color btnBgColor = isActionHovered ? LIGHTGRAY : RAYWHITE;
 
             DrawRectangleRec(actionBtn, btnBgColor);
             DrawRectangleLinesEx(actionBtn, 1, isActionHovered ? DARKGRAY : GRAY);
             IconRenderer::drawStructureIcon(actionBtn, isActionHovered ? DARKBLUE : DARKGRAY);
-
-            if (isActionHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && onActionButton)
-                onActionButton(items[i].text);
-
-            BeginScissorMode(bounds.x, bounds.y, bounds.width - SCROLLBAR_WIDTH, bounds.height);
         }
 
         if (i < items.size() - 1)
@@ -79,53 +108,42 @@ void ScrollableList::drawItems(const std::vector<ListItem>& items)
     }
 }
 
-void ScrollableList::drawItem(const ListItem& item, Rectangle itemRect, bool isHovered)
+void ScrollableList::drawItem(size_t index, Rectangle itemRect, bool isHovered)
 {
+    const ListItem& item = items[index];
     Color bgColor = item.isSelected ? Color{230, 240, 255, 255} : isHovered ? Color{245, 245, 245, 255} : RAYWHITE;
     DrawRectangleRec(itemRect, bgColor);
 
-    if (isHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && onItemClick)
-        onItemClick(item.text);
-
-    int textWidth = MeasureText(item.text.c_str(), 16);
-    float maxTextWidth = itemRect.width - 20;
+    DrawText(labelFor(index).display.c_str(), itemRect.x + 10, itemRect.y + (itemHeight - FONT_SIZE) / 2, FONT_SIZE,
+             isHovered || item.isSelected ? DARKBLUE : BLACK);
 
-    if (textWidth > maxTextWidth)
+    if (item.tag)
     {
-        std::string truncated = item.text;
-
-        while (MeasureText(truncated.c_str(), 16) > maxTextWidth - MeasureText("...", 16))
-            truncated = truncated.substr(0, truncated.length() - 1);
-
-        truncated += "...";
-
-        DrawText(truncated.c_str(), itemRect.x + 10, itemRect.y + (itemHeight - 16) / 2, 16,
-                 isHovered || item.isSelected ? DARKBLUE : BLACK);
-
-        if (isHovered)
-        {
-            EndScissorMode();
+        int tagWidth = TextMetrics::measure(item.tag, TAG_FONT_SIZE);
+        DrawText(item.tag, itemRect.x + itemRect.width - tagWidth - 6, itemRect.y + (itemHeight - TAG_FONT_SIZE) / 2, TAG_FONT_SIZE, GRAY);
+    }
+}
 
-            float tooltipWidth = MeasureText(item.text.c_str(), 14) + 20;
-            float tooltipX = itemRect.x + itemRect.width + 10;
-            float tooltipY = GetMousePosition().y - 15;
+const TextLayoutCache::Layout& ScrollableList::labelFor(size_t index) const
+{
+    const ListItem& item = items[index];
+    float maxTextWidth = itemBounds(item, index).width - 20 - (item.tag ? TAG_WIDTH : 0.0f);
+    return TextLayoutCache::fit(item.text, maxTextWidth, FONT_SIZE);
+}
 
-            if (tooltipX + tooltipWidth > GetScreenWidth())
-                tooltipX = itemRect.x - tooltipWidth - 10;
+void ScrollableList::drawTooltip(const std::string& text, Rectangle itemRect)
+{
+    float tooltipWidth = MeasureText(text.c_str(), 14) + 20;
+    float tooltipX = itemRect.x + itemRect.width + 10;
+    float tooltipY = GetMousePosition().y - 15;
 
-            Rectangle tooltipRect = {tooltipX, tooltipY, tooltipWidth, 25};
+    if (tooltipX + tooltipWidth > GetScreenWidth())
+        tooltipX = itemRect.x - tooltipWidth - 10;
 
-            DrawRectangleRounded(tooltipRect, 0.2f, 4, Color{50, 50, 50, 230});
-            DrawText(item.text.c_str(), tooltipRect.x + 10, tooltipRect.y + 5, 14, WHITE);
+    Rectangle tooltipRect = {tooltipX, tooltipY, tooltipWidth, 25};
 
-            BeginScissorMode(bounds.x, bounds.y, bounds.width - SCROLLBAR_WIDTH, bounds.height);
-        }
-    }
-    else
-    {
-        DrawText(item.text.c_str(), itemRect.x + 10, itemRect.y + (itemHeight - 16) / 2, 16,
-                 isHovered || item.isSelected ? DARKBLUE : BLACK);
-    }
+    DrawRectangleRounded(tooltipRect, 0.2f, 4, Color{50, 50, 50, 230});
+    DrawText(text.c_str(), tooltipRect.x + 10, tooltipRect.y + 5, 14, WHITE);
 }
 
 void ScrollableList::handleScrolling(float contentHeight)
@@ -143,6 +161,33 @@ void ScrollableList::handleScrolling(float contentHeight)
     }
 }
 
+void ScrollableList::updateHover()
+{
+    hoveredItem = -1;
+    actionHovered = false;
+
+    Vector2 mouse = GetMousePosition();
+    if (!CheckCollisionPointRec(mouse, bounds) || itemHeight <= 0)
+        return;
+
+    size_t index = static_cast<size_t>((mouse.y - bounds.y + listScroll) / itemHeight);
+    if (index >= items.size())
+        return;
+
+    Rectangle itemRect = itemBounds(items[index], index);
+    Rectangle actionBtn = {itemRect.x + itemRect.width, itemRect.y, ACTION_BUTTON_WIDTH, itemHeight};
+
+    if (CheckCollisionPointRec(mouse, itemRect))
+    {
+        hoveredItem = static_cast<int>(index);
+    }
+    else if (items[index].hasActionButton && CheckCollisionPointRec(mouse, actionBtn))
+    {
+        hoveredItem = static_cast<int>(index);
+        actionHovered = true;
+    }
+}
+
 void ScrollableList::drawScrollbar(float contentHeight)
 {
     float maxScroll = std::max(0.0f, contentHeight - bounds.height);
@@ -151,17 +196,40 @@ void ScrollableList::drawScrollbar(float contentHeight)
         Rectangle scrollBarBg = {bounds.x + bounds.width - SCROLLBAR_WIDTH, bounds.y, SCROLLBAR_WIDTH, bounds.height};
         DrawRectangleRec(scrollBarBg, Color{245, 245, 245, 255});
 
-        float visiblePortion = bounds.height / contentHeight;
-        float scrollBarHeight = bounds.height * visiblePortion;
-        float scrollBarY = bounds.y + (listScroll / maxScroll) * (bounds.height - scrollBarHeight);
-
-        Rectangle scrollBarRect = {scrollBarBg.x, scrollBarY, SCROLLBAR_WIDTH, scrollBarHeight};
+        Rectangle scrollBarRect = scrollbarThumb(contentHeight);
 
         bool isScrollBarHovered = CheckCollisionPointRec(GetMousePosition(), scrollBarRect);
         DrawRectangleRec(scrollBarRect, isScrollBarHovered ? Color{130, 130, 130, 255} : Color{180, 180, 180, 255});
     }
 }
 
+Rectangle ScrollableList::itemBounds(const ListItem& item, size_t index) const
+{
+    float itemWidth = item.hasActionButton ? bounds.width - ACTION_BUTTON_WIDTH - SCROLLBAR_WIDTH : bounds.width - SCROLLBAR_WIDTH;
+    return Rectangle{bounds.x + 1, bounds.y + index * itemHeight - listScroll, itemWidth, itemHeight};
+}
+
+Rectangle ScrollableList::scrollbarThumb(float contentHeight) const
+{
+    float maxScroll = std::max(0.0f, contentHeight - bounds.height);
+    if (maxScroll <= 0)
+        return Rectangle{};
+
+    float scrollBarHeight = bounds.height * (bounds.height / contentHeight);
+    float scrollBarY = bounds.y + (listScroll / maxScroll) * (bounds.height - scrollBarHeight);
+    return Rectangle{bounds.x + bounds.width - SCROLLBAR_WIDTH, scrollBarY, SCROLLBAR_WIDTH, scrollBarHeight};
+}
+
+uint64_t ScrollableList::stateKey(float contentHeight) const
+{
+    bool thumbHovered = CheckCollisionPointRec(GetMousePosition(), scrollbarThumb(contentHeight));
+
+    uint64_t key = RenderCache::combine(itemsVersion, bounds);
+    key = RenderCache::combine(key, listScroll);
+    key = RenderCache::combine(key, static_cast<uint64_t>(hoveredItem + 1));
+    return RenderCache::combine(key, static_cast<uint64_t>(actionHovered) << 1 | thumbHovered);
+}
+
 void ScrollableList::setCallbacks(ItemClickCallback onClick, ActionButtonCallback onAction)
 {
     onItemClick = std::move(onClick);
@@ -6,6 +6,11 @@
 
 #include <raylib.h>
 
+#include "RenderCache.h"
+#include "TextLayoutCache.h"
+
+// The item model is set when the underlying data changes and kept between frames. Truncated labels come from
+// TextLayoutCache, so each frame only touches the visible slice.
 class ScrollableList
 {
 public:
@@ -23,17 +28,22 @@ public:
         bool isSelected = false;
         bool hasActionButton = false;
         DatabaseObjectType type = DatabaseObjectType::Table;
+        const char* tag = nullptr; // Short label drawn at the right edge, e.g. the object kind in search results
     };
 
 public:
-    using ItemClickCallback = std::function<void(const std::string&)>;
-    using ActionButtonCallback = std::function<void(const std::string&)>;
+    using ItemClickCallback = std::function<void(const ListItem&)>;
+    using ActionButtonCallback = std::function<void(const ListItem&)>;
 
 public:
     ScrollableList(const char* title, float x, float y, float width, float height, float itemHeight, float titleY = -1);
 
 public:
-    void render(const std::vector<ListItem>& items);
+    void render();
+
+    void setItems(std::vector<ListItem> newItems);
+    void setSelectedIndex(int index);
+    const std::vector<ListItem>& getItems() const { return items; }
 
     void setCallbacks(ItemClickCallback onClick, ActionButtonCallback onAction = nullptr);
     void setScroll(float scroll) { listScroll = scroll; }
@@ -42,24 +52,40 @@ public:
 
 private:
     void drawHeader();
-    void drawListBackground();
-    void drawItems(const std::vector<ListItem>& items);
-    void drawItem(const ListItem& item, Rectangle itemRect, bool isHovered);
+    void drawItems();
+    void drawItem(size_t index, Rectangle itemRect, bool isHovered);
     void handleScrolling(float contentHeight);
+    void updateHover();
     void drawScrollbar(float contentHeight);
     void drawTooltip(const std::string& text, Rectangle itemRect);
 
+    const TextLayoutCache::Layout& labelFor(size_t index) const;
+    Rectangle itemBounds(const ListItem& item, size_t index) const;
+    Rectangle scrollbarThumb(float contentHeight) const;
+    uint64_t stateKey(float contentHeight) const;
+
 private:
     std::string title;
     Rectangle bounds;
     float itemHeight;
     float listScroll = 0.0f;
 
+    std::vector<ListItem> items;
+    uint64_t itemsVersion = 0;
+
+    // Hover is resolved before drawing so it can be part of the cache key
+    int hoveredItem = -1;
+    bool actionHovered = false;
+    RenderCache cache;
+
     ItemClickCallback onItemClick;
     ActionButtonCallback onActionButton;
 
     static constexpr float ACTION_BUTTON_WIDTH = 35.0f;
     static constexpr float SCROLLBAR_WIDTH = 8.0f;
+    static constexpr int FONT_SIZE = 16;
+    static constexpr int TAG_FONT_SIZE = 12;
+    static constexpr float TAG_WIDTH = 40.0f;
 
     float titleY;
 };
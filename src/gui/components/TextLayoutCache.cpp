@@ -0,0 +1,75 @@
+#include "TextLayoutCache.h"
+#include "RenderCache.h"
+#include "TextMetrics.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+std::unordered_map<uint64_t, TextLayoutCache::Layout> TextLayoutCache::layouts;
+std::deque<TextLayoutCache::Layout> TextLayoutCache::collisions;
+bool TextLayoutCache::clearPending = false;
+
+const TextLayoutCache::Layout& TextLayoutCache::fit(std::string_view text, float maxWidth, int fontSize)
+{
+    uint64_t key = static_cast<uint64_t>(std::hash<std::string_view>{}(text));
+    key = RenderCache::combine(RenderCache::combine(key, static_cast<uint64_t>(static_cast<int>(maxWidth))), static_cast<uint64_t>(fontSize));
+
+    auto it = layouts.find(key);
+    if (it == layouts.end())
+        return layouts.emplace(key, layout(text, maxWidth, fontSize)).first->second;
+    if (it->second.source == text)
+        return it->second;
+
+    // A hash collision must not overwrite a layout a caller may still hold this frame
+    collisions.push_back(layout(text, maxWidth, fontSize));
+    return collisions.back();
+}
+
+void TextLayoutCache::beginFrame()
+{
+    if (clearPending || layouts.size() >= MAX_LAYOUTS)
+        layouts.clear();
+    collisions.clear();
+    clearPending = false;
+}
+
+TextLayoutCache::Layout TextLayoutCache::layout(std::string_view text, float maxWidth, int fontSize)
+{
+    Layout result;
+    result.source = std::string(text);
+    result.width = TextMetrics::measure(text, fontSize);
+
+    if (result.width <= maxWidth)
+    {
+        result.display = result.source;
+        result.displayWidth = result.width;
+        return result;
+    }
+
+    // prefix[k] is the advance of the first k glyphs, ends[k] the byte offset just past them
+    std::vector<float> prefix{0.0f};
+    std::vector<size_t> ends{0};
+    for (size_t pos = 0; pos < text.size();)
+    {
+        float advance = TextMetrics::advance(TextMetrics::nextCodepoint(text, pos), fontSize);
+        prefix.push_back(prefix.back() + advance);
+        ends.push_back(pos);
+    }
+
+    float limit = maxWidth - TextMetrics::measure("...", fontSize);
+
+    // Not even the ellipsis fits, a column this narrow shows nothing
+    if (limit < 0.0f)
+    {
+        result.truncated = true;
+        return result;
+    }
+
+    size_t glyphs = static_cast<size_t>(std::upper_bound(prefix.begin(), prefix.end(), limit) - prefix.begin()) - 1;
+
+    result.display = result.source.substr(0, ends[glyphs]) + "...";
+    result.displayWidth = TextMetrics::measure(result.display, fontSize);
+    result.truncated = true;
+    return result;
+}
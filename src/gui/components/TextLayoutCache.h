@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Ellipsis truncation for the default font, computed once per (text, width, font size) and reused across frames.
+// The cut point is found by binary search over prefix sums of the glyph advances instead of re-measuring
+// shorter and shorter copies of the string.
+class TextLayoutCache
+{
+public:
+    struct Layout
+    {
+        std::string source;   // Text the layout was made for, guards against hash collisions
+        std::string display;  // Text to draw, the source itself, a prefix followed by "..." or empty when that does not fit
+        int width = 0;        // Width of the full source text
+        int displayWidth = 0; // Width of the display text
+        bool truncated = false;
+    };
+
+public:
+    // The layout stays valid until the next beginFrame(), callers may hold several within a frame
+    static const Layout& fit(std::string_view text, float maxWidth, int fontSize);
+
+    // Drops every layout at the start of the next frame, for when widths or font sizes change wholesale
+    // (window resize, diagram zoom)
+    static void clear() { clearPending = true; }
+
+    // Evicts between frames only, once clear() was called or the cache grew past its limit
+    static void beginFrame();
+
+private:
+    static Layout layout(std::string_view text, float maxWidth, int fontSize);
+
+private:
+    static std::unordered_map<uint64_t, Layout> layouts; // Node based, entries never move while it grows
+    static std::deque<Layout> collisions;                // Layouts whose key was taken, kept for the current frame
+    static bool clearPending;
+
+    static constexpr size_t MAX_LAYOUTS = 16384;
+};
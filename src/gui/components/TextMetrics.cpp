@@ -0,0 +1,90 @@
+#include "TextMetrics.h"
+
+#include <algorithm>
+
+#include <raylib.h>
+
+int TextMetrics::measure(std::string_view text, int fontSize)
+{
+    if (text.empty())
+        return 0;
+
+    const auto& table = advances();
+    fontSize = std::max(fontSize, DEFAULT_FONT_SIZE);
+
+    float scale = static_cast<float>(fontSize) / GetFontDefault().baseSize;
+    int spacing = fontSize / DEFAULT_FONT_SIZE;
+
+    float lineWidth = 0.0f;
+    float maxWidth = 0.0f;
+    int glyphs = 0;
+    int maxGlyphs = 0;
+
+    for (size_t pos = 0; pos < text.size();)
+    {
+        int codepoint = nextCodepoint(text, pos);
+
+        glyphs++;
+        if (codepoint == '\n')
+        {
+            maxWidth = std::max(maxWidth, lineWidth);
+            lineWidth = 0.0f;
+            glyphs = 0;
+        }
+        else
+        {
+            lineWidth += table[codepoint];
+        }
+        maxGlyphs = std::max(maxGlyphs, glyphs);
+    }
+
+    maxWidth = std::max(maxWidth, lineWidth);
+    return static_cast<int>(maxWidth * scale + static_cast<float>((maxGlyphs - 1) * spacing));
+}
+
+float TextMetrics::advance(int codepoint, int fontSize)
+{
+    fontSize = std::max(fontSize, DEFAULT_FONT_SIZE);
+    float scale = static_cast<float>(fontSize) / GetFontDefault().baseSize;
+    return advances()[codepoint & 0xFF] * scale + static_cast<float>(fontSize / DEFAULT_FONT_SIZE);
+}
+
+int TextMetrics::nextCodepoint(std::string_view text, size_t& pos)
+{
+    unsigned char c = static_cast<unsigned char>(text[pos]);
+    size_t length = 1;
+
+    if (c >= 0xF0)
+        length = 4;
+    else if (c >= 0xE0)
+        length = 3;
+    else if (c >= 0xC0)
+        length = 2;
+
+    int codepoint = c;
+    if (length == 2 && pos + 1 < text.size())
+        codepoint = ((c & 0x1F) << 6) | (text[pos + 1] & 0x3F);
+    else if (length > 1)
+        codepoint = FALLBACK_GLYPH;
+
+    pos = std::min(text.size(), pos + length);
+    return codepoint > 0xFF ? FALLBACK_GLYPH : codepoint;
+}
+
+const std::array<float, 256>& TextMetrics::advances()
+{
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> result{};
+        Font font = GetFontDefault();
+
+        for (int codepoint = 0; codepoint < 256; ++codepoint)
+        {
+            int index = GetGlyphIndex(font, codepoint);
+            const GlyphInfo& glyph = font.glyphs[index];
+            result[codepoint] = glyph.advanceX != 0 ? glyph.advanceX : font.recs[index].width + glyph.offsetX;
+        }
+        return result;
+    }();
+
+    return table;
+}
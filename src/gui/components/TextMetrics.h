@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+// Text width estimation for the default font from a per-glyph advance table. Gives the same widths
+// as MeasureText without decoding glyph rectangles for every call.
+class TextMetrics
+{
+public:
+    // Width of the widest line in pixels, matching MeasureText(text, fontSize)
+    static int measure(std::string_view text, int fontSize);
+
+    // Horizontal distance to the next glyph, including the spacing DrawText puts between glyphs
+    static float advance(int codepoint, int fontSize);
+
+    // Decodes the codepoint at pos and moves pos past it, anything beyond Latin-1 maps to the fallback glyph
+    static int nextCodepoint(std::string_view text, size_t& pos);
+
+private:
+    static const std::array<float, 256>& advances();
+
+private:
+    static constexpr int DEFAULT_FONT_SIZE = 10;
+    static constexpr char FALLBACK_GLYPH = '?';
+};
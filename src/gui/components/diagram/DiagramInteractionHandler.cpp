@@ -1,7 +1,9 @@
 #include "DiagramInteractionHandler.h"
 
+#include "../../../core/logging/Logger.h"
+
 #include <algorithm>
-#include <iostream>
+#include <cmath>
 
 DiagramInteractionHandler::DiagramInteractionHandler(Rectangle bounds)
     : bounds(bounds)
@@ -16,7 +18,7 @@ void DiagramInteractionHandler::handleZooming(float& zoom)
         if (wheel != 0)
         {
             zoom = std::clamp(zoom + wheel * ZOOM_STEP, MIN_ZOOM, MAX_ZOOM);
-            std::cout << "Zoom adjusted to: " << zoom << std::endl;
+            LOG_DEBUG("Zoom adjusted to: " << zoom);
         }
     }
 }
@@ -26,12 +28,12 @@ void DiagramInteractionHandler::handlePanning(Vector2& pan, bool& isPanning)
     if (IsMouseButtonPressed(MOUSE_MIDDLE_BUTTON))
     {
         isPanning = true;
-        std::cout << "Started panning" << std::endl;
+        LOG_DEBUG("Started panning");
     }
     else if (IsMouseButtonReleased(MOUSE_MIDDLE_BUTTON))
     {
         isPanning = false;
-        std::cout << "Stopped panning" << std::endl;
+        LOG_DEBUG("Stopped panning");
     }
 
     if (isPanning)
@@ -39,54 +41,70 @@ void DiagramInteractionHandler::handlePanning(Vector2& pan, bool& isPanning)
         Vector2 delta = GetMouseDelta();
         pan.x += delta.x;
         pan.y += delta.y;
-        std::cout << "Panning: " << pan.x << ", " << pan.y << std::endl;
+        LOG_TRACE("Panning: " << pan.x << ", " << pan.y);
     }
 }
 
-void DiagramInteractionHandler::handleTableDragging(std::unordered_map<std::string, Diagram::TableNode>& tables, const Vector2& pan,
-                                                    float zoom)
+bool DiagramInteractionHandler::handleTableDragging(std::vector<Diagram::TableNode>& tables, const DiagramSpatialIndex& index,
+                                                    const Vector2& pan, float zoom)
 {
+    if (draggedTable >= static_cast<int>(tables.size()))
+        draggedTable = -1;
 
     Vector2 mousePos = GetMousePosition();
 
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
     {
-        for (auto& [name, table] : tables)
+        Vector2 worldPos = {(mousePos.x - bounds.x - pan.x) / zoom, (mousePos.y - bounds.y - pan.y) / zoom};
+        int hit = CheckCollisionPointRec(mousePos, bounds) ? index.tableAt(worldPos) : -1;
+        if (hit >= 0)
         {
-            Rectangle tableRect = {bounds.x + table.position.x * zoom + pan.x, bounds.y + table.position.y * zoom + pan.y,
-                                   table.size.x * zoom, table.size.y * zoom};
-
-            if (CheckCollisionPointRec(mousePos, tableRect))
-            {
-                table.isSelected = true;
-                table.isDragging = true;
-                std::cout << "Started dragging table: " << name << std::endl;
-                break;
-            }
+            draggedTable = hit;
+            dragDistance = 0.0f;
+            tables[hit].isSelected = true;
+            tables[hit].isDragging = true;
+            LOG_DEBUG("Started dragging table: " << tables[hit].name);
+            return true;
         }
     }
     else if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
     {
-        for (auto& [name, table] : tables)
+        if (draggedTable >= 0)
         {
-            if (table.isDragging)
-                std::cout << "Stopped dragging table: " << name << std::endl;
-
-            table.isDragging = false;
+            LOG_DEBUG("Stopped dragging table: " << tables[draggedTable].name);
+            tables[draggedTable].isDragging = false;
+            if (dragDistance < CLICK_SLOP)
+                clickedTable = draggedTable;
+            draggedTable = -1;
         }
     }
 
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+    if (draggedTable >= 0 && IsMouseButtonDown(MOUSE_LEFT_BUTTON))
     {
         Vector2 delta = GetMouseDelta();
-        for (auto& [name, table] : tables)
-        {
-            if (table.isDragging)
-            {
-                table.position.x += delta.x / zoom;
-                table.position.y += delta.y / zoom;
-                std::cout << "Dragging table " << name << " to: " << table.position.x << ", " << table.position.y << std::endl;
-            }
-        }
+        if (delta.x == 0 && delta.y == 0)
+            return false;
+
+        dragDistance += std::fabs(delta.x) + std::fabs(delta.y);
+        auto& table = tables[draggedTable];
+        table.position.x += delta.x / zoom;
+        table.position.y += delta.y / zoom;
+        LOG_TRACE("Dragging table " << table.name << " to: " << table.position.x << ", " << table.position.y);
+        return true;
     }
+
+    return false;
+}
+
+void DiagramInteractionHandler::cancelDrag()
+{
+    draggedTable = -1;
+    clickedTable = -1;
+}
+
+int DiagramInteractionHandler::takeClickedTable()
+{
+    int clicked = clickedTable;
+    clickedTable = -1;
+    return clicked;
 }
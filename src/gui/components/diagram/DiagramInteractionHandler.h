@@ -1,8 +1,9 @@
 #pragma once
 
+#include "DiagramSpatialIndex.h"
 #include "DiagramTypes.h"
 
-#include <unordered_map>
+#include <vector>
 
 #include <raylib.h>
 
@@ -14,11 +15,21 @@ public:
 public:
     void handleZooming(float& zoom);
     void handlePanning(Vector2& pan, bool& isPanning);
-    void handleTableDragging(std::unordered_map<std::string, Diagram::TableNode>& tables, const Vector2& pan, float zoom);
+    // Returns true when a table moved this frame
+    bool handleTableDragging(std::vector<Diagram::TableNode>& tables, const DiagramSpatialIndex& index, const Vector2& pan,
+                             float zoom);
+    void cancelDrag();
+    int getDraggedTable() const { return draggedTable; }
+    // Table pressed and released without being moved since the last call, -1 if none
+    int takeClickedTable();
 
 private:
     Rectangle bounds;
-    static constexpr float MIN_ZOOM = 0.5f;
+    int draggedTable = -1;
+    int clickedTable = -1;
+    float dragDistance = 0.0f; // Pixels moved since the press, tells a click from a drag
+    static constexpr float MIN_ZOOM = 0.1f;
     static constexpr float MAX_ZOOM = 2.0f;
     static constexpr float ZOOM_STEP = 0.1f;
+    static constexpr float CLICK_SLOP = 4.0f;
 };
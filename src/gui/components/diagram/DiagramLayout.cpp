@@ -0,0 +1,338 @@
+#include "DiagramLayout.h"
+
+#include "../../core/FramePacer.h"
+#include "../../../core/logging/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+DiagramLayout::~DiagramLayout()
+{
+    cancel();
+}
+
+void DiagramLayout::start(Graph graph)
+{
+    cancel();
+
+    cancelled = false;
+    running = true;
+    worker = std::thread([this, graph = std::move(graph)]() { run(graph); });
+}
+
+void DiagramLayout::cancel()
+{
+    cancelled = true;
+    if (worker.joinable())
+        worker.join();
+    running = false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+    hasPending = false;
+}
+
+bool DiagramLayout::takePositions(std::vector<Vector2>& positions)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasPending)
+        return false;
+
+    positions.swap(pending);
+    hasPending = false;
+    return true;
+}
+
+void DiagramLayout::publish(std::vector<Vector2> positions)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = std::move(positions);
+        hasPending = true;
+    }
+    FramePacer::wake();
+}
+
+void DiagramLayout::run(const Graph& graph)
+{
+    try
+    {
+        uint32_t count = static_cast<uint32_t>(graph.sizes.size());
+        std::vector<std::vector<uint32_t>> outgoing(count);
+        std::vector<std::vector<uint32_t>> neighbors(count);
+        std::vector<uint32_t> parent(count);
+        std::iota(parent.begin(), parent.end(), 0);
+
+        auto root = [&](uint32_t id) {
+            while (parent[id] != id)
+                id = parent[id] = parent[parent[id]];
+            return id;
+        };
+
+        for (const auto& [from, to] : graph.edges)
+        {
+            if (from == to || from >= count || to >= count)
+                continue;
+
+            outgoing[from].push_back(to);
+            neighbors[from].push_back(to);
+            neighbors[to].push_back(from);
+            parent[root(from)] = root(to);
+        }
+
+        std::vector<int> layer = assignLayers(count, outgoing);
+
+        // Components in order of their lowest table id, layers numbered from zero within each
+        std::vector<int> componentOf(count, -1);
+        std::vector<int> firstLayer;
+        for (uint32_t id = 0; id < count; ++id)
+        {
+            int& component = componentOf[root(id)];
+            if (component < 0)
+            {
+                component = static_cast<int>(firstLayer.size());
+                firstLayer.push_back(layer[id]);
+            }
+            firstLayer[component] = std::min(firstLayer[component], layer[id]);
+        }
+
+        std::vector<Component> components(firstLayer.size());
+        for (uint32_t id = 0; id < count; ++id)
+        {
+            int component = componentOf[root(id)];
+            size_t index = static_cast<size_t>(layer[id] - firstLayer[component]);
+            auto& layers = components[component].layers;
+            if (layers.size() <= index)
+                layers.resize(index + 1);
+            layers[index].push_back(id);
+        }
+
+        std::vector<float> rank(count, 0.0f);
+        for (const auto& component : components)
+        {
+            for (const auto& ids : component.layers)
+            {
+                for (size_t i = 0; i < ids.size(); ++i)
+                    rank[ids[i]] = (i + 0.5f) / ids.size();
+            }
+        }
+
+        publish(place(components, graph.sizes));
+
+        for (int pass = 0; pass < ORDERING_PASSES; ++pass)
+        {
+            if (cancelled)
+                break;
+
+            for (auto& component : components)
+                orderPass(component, neighbors, layer, rank, pass % 2 == 0);
+
+            publish(place(components, graph.sizes));
+        }
+
+        LOG_DEBUG("Laid out " << count << " tables in " << components.size() << " groups");
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Diagram layout failed: " << e.what());
+    }
+
+    running = false;
+    FramePacer::wake();
+}
+
+std::vector<int> DiagramLayout::assignLayers(uint32_t count, const std::vector<std::vector<uint32_t>>& outgoing)
+{
+    // Reverse post-order of a depth-first search is a topological order once the edges closing cycles are dropped,
+    // and those are exactly the edges that point backwards in it
+    enum : uint8_t
+    {
+        UNSEEN,
+        OPEN,
+        DONE
+    };
+    std::vector<uint8_t> state(count, UNSEEN);
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    std::vector<std::pair<uint32_t, size_t>> stack;
+
+    for (uint32_t start = 0; start < count; ++start)
+    {
+        if (state[start] != UNSEEN)
+            continue;
+
+        state[start] = OPEN;
+        stack.push_back({start, 0});
+        while (!stack.empty())
+        {
+            uint32_t node = stack.back().first;
+            size_t& next = stack.back().second;
+            if (next < outgoing[node].size())
+            {
+                uint32_t target = outgoing[node][next++];
+                if (state[target] == UNSEEN)
+                {
+                    state[target] = OPEN;
+                    stack.push_back({target, 0});
+                }
+            }
+            else
+            {
+                state[node] = DONE;
+                order.push_back(node);
+                stack.pop_back();
+            }
+        }
+    }
+    std::reverse(order.begin(), order.end());
+
+    std::vector<uint32_t> position(count);
+    for (uint32_t i = 0; i < count; ++i)
+        position[order[i]] = i;
+
+    // Longest path, a referenced table goes one layer right of everything referencing it
+    std::vector<int> layer(count, 0);
+    std::vector<bool> referenced(count, false);
+    for (uint32_t node : order)
+    {
+        for (uint32_t target : outgoing[node])
+        {
+            if (position[target] > position[node])
+            {
+                layer[target] = std::max(layer[target], layer[node] + 1);
+                referenced[target] = true;
+            }
+        }
+    }
+
+    // Tables nothing references sit right next to their nearest target instead of all in the first layer
+    for (uint32_t node = 0; node < count; ++node)
+    {
+        if (referenced[node])
+            continue;
+
+        int nearest = std::numeric_limits<int>::max();
+        for (uint32_t target : outgoing[node])
+        {
+            if (position[target] > position[node])
+                nearest = std::min(nearest, layer[target]);
+        }
+        if (nearest != std::numeric_limits<int>::max())
+            layer[node] = nearest - 1;
+    }
+
+    return layer;
+}
+
+void DiagramLayout::orderPass(Component& component, const std::vector<std::vector<uint32_t>>& neighbors, const std::vector<int>& layer,
+                              std::vector<float>& rank, bool forward)
+{
+    // Each table moves to the average rank of its neighbours in the layers already swept, tables without any keep theirs
+    std::vector<std::pair<float, uint32_t>> keys;
+    size_t layerCount = component.layers.size();
+
+    for (size_t step = 1; step < layerCount; ++step)
+    {
+        auto& ids = component.layers[forward ? step : layerCount - 1 - step];
+
+        keys.clear();
+        for (uint32_t id : ids)
+        {
+            float sum = 0.0f;
+            int seen = 0;
+            for (uint32_t other : neighbors[id])
+            {
+                if (forward ? layer[other] < layer[id] : layer[other] > layer[id])
+                {
+                    sum += rank[other];
+                    seen++;
+                }
+            }
+            keys.push_back({seen > 0 ? sum / seen : rank[id], id});
+        }
+
+        std::stable_sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            ids[i] = keys[i].second;
+            rank[ids[i]] = (i + 0.5f) / ids.size();
+        }
+    }
+}
+
+std::vector<Vector2> DiagramLayout::place(std::vector<Component>& components, const std::vector<Vector2>& sizes)
+{
+    std::vector<Vector2> positions(sizes.size(), Vector2{0, 0});
+
+    // Layers become columns, each centred on the tallest one
+    float totalArea = 0.0f;
+    float widest = 0.0f;
+    for (auto& component : components)
+    {
+        std::vector<float> widths, heights;
+        for (const auto& ids : component.layers)
+        {
+            float width = 0.0f, height = 0.0f;
+            for (uint32_t id : ids)
+            {
+                width = std::max(width, sizes[id].x);
+                height += sizes[id].y + TABLE_GAP;
+            }
+            widths.push_back(width);
+            heights.push_back(ids.empty() ? 0.0f : height - TABLE_GAP);
+        }
+
+        float tallest = heights.empty() ? 0.0f : *std::max_element(heights.begin(), heights.end());
+        float x = 0.0f;
+        for (size_t l = 0; l < component.layers.size(); ++l)
+        {
+            if (component.layers[l].empty())
+                continue;
+
+            float y = (tallest - heights[l]) / 2;
+            for (uint32_t id : component.layers[l])
+            {
+                positions[id] = {x, y};
+                y += sizes[id].y + TABLE_GAP;
+            }
+            x += widths[l] + LAYER_GAP;
+        }
+
+        component.size = {std::max(0.0f, x - LAYER_GAP), tallest};
+        totalArea += (component.size.x + COMPONENT_GAP) * (component.size.y + COMPONENT_GAP);
+        widest = std::max(widest, component.size.x);
+    }
+
+    // Components are packed tallest first into rows about as wide as the whole diagram is high
+    std::vector<size_t> order(components.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return components[a].size.y > components[b].size.y; });
+
+    float rowWidth = std::max(widest, std::sqrt(totalArea) * 1.5f);
+    float x = 0.0f, y = 0.0f, rowHeight = 0.0f;
+    for (size_t index : order)
+    {
+        const auto& component = components[index];
+        if (x > 0.0f && x + component.size.x > rowWidth)
+        {
+            x = 0.0f;
+            y += rowHeight + COMPONENT_GAP;
+            rowHeight = 0.0f;
+        }
+
+        Vector2 offset = {x + 50, y + 50};
+        for (const auto& ids : component.layers)
+        {
+            for (uint32_t id : ids)
+                positions[id] = {positions[id].x + offset.x, positions[id].y + offset.y};
+        }
+
+        x += component.size.x + COMPONENT_GAP;
+        rowHeight = std::max(rowHeight, component.size.y);
+    }
+
+    return positions;
+}
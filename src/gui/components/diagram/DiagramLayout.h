@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <raylib.h>
+
+// Layered placement of tables along the foreign key graph, computed on a worker thread. Referencing tables go
+// left of the tables they reference, crossings are reduced by barycenter ordering passes, and every connected
+// group of tables is laid out on its own before the groups are packed into rows. Positions are published after
+// every pass so the diagram can show progress.
+class DiagramLayout
+{
+public:
+    struct Graph
+    {
+        std::vector<Vector2> sizes;
+        std::vector<std::pair<uint32_t, uint32_t>> edges; // Referencing table, referenced table
+    };
+
+public:
+    DiagramLayout() = default;
+    DiagramLayout(const DiagramLayout&) = delete;
+    DiagramLayout& operator=(const DiagramLayout&) = delete;
+    ~DiagramLayout();
+
+    // Stops a layout that is still running and starts over on the new graph
+    void start(Graph graph);
+    void cancel();
+    bool isRunning() const { return running; }
+
+    // Latest positions not taken yet, indexed like Graph::sizes
+    bool takePositions(std::vector<Vector2>& positions);
+
+private:
+    struct Component
+    {
+        std::vector<std::vector<uint32_t>> layers; // Table ids per layer in their current order
+        Vector2 size = {0, 0};
+    };
+
+    void run(const Graph& graph);
+    void publish(std::vector<Vector2> positions);
+
+    static std::vector<int> assignLayers(uint32_t count, const std::vector<std::vector<uint32_t>>& outgoing);
+    static void orderPass(Component& component, const std::vector<std::vector<uint32_t>>& neighbors, const std::vector<int>& layer,
+                          std::vector<float>& rank, bool forward);
+    static std::vector<Vector2> place(std::vector<Component>& components, const std::vector<Vector2>& sizes);
+
+private:
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<bool> cancelled{false};
+
+    std::mutex mutex;
+    std::vector<Vector2> pending;
+    bool hasPending = false;
+
+private:
+    static constexpr int ORDERING_PASSES = 8;
+    static constexpr float LAYER_GAP = 120.0f;
+    static constexpr float TABLE_GAP = 40.0f;
+    static constexpr float COMPONENT_GAP = 160.0f;
+};
@@ -0,0 +1,135 @@
+#include "DiagramSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+void DiagramSpatialIndex::build(const std::vector<Diagram::TableNode>& tableNodes, const std::vector<Rectangle>& edgeBounds)
+{
+    clear();
+
+    for (uint32_t id = 0; id < tableNodes.size(); ++id)
+        insert(tables, id, tableBounds(tableNodes[id]));
+
+    for (uint32_t id = 0; id < edgeBounds.size(); ++id)
+        insert(edges, id, edgeBounds[id]);
+}
+
+void DiagramSpatialIndex::clear()
+{
+    tables = Grid();
+    edges = Grid();
+}
+
+void DiagramSpatialIndex::queryTables(Rectangle area, std::vector<uint32_t>& result) const
+{
+    query(tables, area, result);
+}
+
+void DiagramSpatialIndex::queryEdges(Rectangle area, std::vector<uint32_t>& result) const
+{
+    query(edges, area, result);
+}
+
+int DiagramSpatialIndex::tableAt(Vector2 point) const
+{
+    int found = -1;
+
+    auto test = [&](uint32_t id) {
+        if (static_cast<int>(id) > found && CheckCollisionPointRec(point, tables.boxes[id]))
+            found = static_cast<int>(id);
+    };
+
+    auto cell = tables.cells.find(cellKey(cellCoordinate(point.x), cellCoordinate(point.y)));
+    if (cell != tables.cells.end())
+    {
+        for (uint32_t id : cell->second)
+            test(id);
+    }
+    for (uint32_t id : tables.oversized)
+        test(id);
+
+    return found;
+}
+
+Rectangle DiagramSpatialIndex::tableBounds(const Diagram::TableNode& table)
+{
+    return Rectangle{table.position.x, table.position.y, table.size.x, table.size.y};
+}
+
+void DiagramSpatialIndex::insert(Grid& grid, uint32_t id, Rectangle box)
+{
+    grid.boxes.push_back(box);
+
+    int x0 = cellCoordinate(box.x);
+    int y0 = cellCoordinate(box.y);
+    int x1 = cellCoordinate(box.x + box.width);
+    int y1 = cellCoordinate(box.y + box.height);
+
+    if (static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1) > MAX_CELLS_PER_ITEM)
+    {
+        grid.oversized.push_back(id);
+        return;
+    }
+
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+            grid.cells[cellKey(x, y)].push_back(id);
+    }
+}
+
+void DiagramSpatialIndex::query(const Grid& grid, Rectangle area, std::vector<uint32_t>& result)
+{
+    result.clear();
+
+    int x0 = cellCoordinate(area.x);
+    int y0 = cellCoordinate(area.y);
+    int x1 = cellCoordinate(area.x + area.width);
+    int y1 = cellCoordinate(area.y + area.height);
+
+    // A viewport wider than the whole diagram covers more cells than there are items, scan the items instead
+    if (static_cast<size_t>(x1 - x0 + 1) * (y1 - y0 + 1) > grid.boxes.size())
+    {
+        for (uint32_t id = 0; id < grid.boxes.size(); ++id)
+        {
+            if (CheckCollisionRecs(area, grid.boxes[id]))
+                result.push_back(id);
+        }
+        return;
+    }
+
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            auto cell = grid.cells.find(cellKey(x, y));
+            if (cell == grid.cells.end())
+                continue;
+
+            for (uint32_t id : cell->second)
+            {
+                if (CheckCollisionRecs(area, grid.boxes[id]))
+                    result.push_back(id);
+            }
+        }
+    }
+
+    for (uint32_t id : grid.oversized)
+    {
+        if (CheckCollisionRecs(area, grid.boxes[id]))
+            result.push_back(id);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+uint64_t DiagramSpatialIndex::cellKey(int x, int y)
+{
+    return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+}
+
+int DiagramSpatialIndex::cellCoordinate(float value)
+{
+    return static_cast<int>(std::floor(value / CELL_SIZE));
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "DiagramTypes.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+// Uniform grid over diagram coordinates (before pan and zoom). Tables and relationship curves are bucketed by
+// their bounding boxes, so drawing only visits what overlaps the viewport and a click only tests one cell.
+class DiagramSpatialIndex
+{
+public:
+    void build(const std::vector<Diagram::TableNode>& tables, const std::vector<Rectangle>& edgeBounds);
+    void clear();
+
+    // Ids overlapping the area in ascending order, which is also the drawing order
+    void queryTables(Rectangle area, std::vector<uint32_t>& result) const;
+    void queryEdges(Rectangle area, std::vector<uint32_t>& result) const;
+
+    // Topmost table under the point, -1 if none
+    int tableAt(Vector2 point) const;
+
+    static Rectangle tableBounds(const Diagram::TableNode& table);
+
+private:
+    struct Grid
+    {
+        std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+        std::vector<uint32_t> oversized; // Items spanning too many cells to bucket, always tested
+        std::vector<Rectangle> boxes;
+    };
+
+    static void insert(Grid& grid, uint32_t id, Rectangle box);
+    static void query(const Grid& grid, Rectangle area, std::vector<uint32_t>& result);
+    static uint64_t cellKey(int x, int y);
+    static int cellCoordinate(float value);
+
+private:
+    Grid tables;
+    Grid edges;
+
+private:
+    static constexpr float CELL_SIZE = 512.0f;
+    static constexpr int MAX_CELLS_PER_ITEM = 64;
+};
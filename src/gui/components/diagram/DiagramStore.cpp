@@ -0,0 +1,217 @@
+#include "DiagramStore.h"
+
+#include "../../../core/logging/Logger.h"
+
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// One record per line, fields separated by tabs:
+//   diagram <version>
+//   fingerprint <text>
+//   view <zoom> <pan x> <pan y>
+//   table <name> <x> <y>
+//   column <name> <type> <primary key 0/1> <foreign key 0/1> <referenced table> <referenced column>
+// Columns belong to the table record before them. Tabs, newlines and backslashes in names are escaped.
+namespace
+{
+std::string escape(const std::string& text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\r':
+            result += "\\r";
+            break;
+        default:
+            result += c;
+        }
+    }
+    return result;
+}
+
+std::string unescape(const std::string& text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] != '\\' || i + 1 == text.size())
+        {
+            result += text[i];
+            continue;
+        }
+
+        char c = text[++i];
+        result += c == 't' ? '\t' : c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+    }
+    return result;
+}
+
+std::vector<std::string> splitFields(const std::string& line)
+{
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true)
+    {
+        size_t tab = line.find('\t', start);
+        fields.push_back(unescape(line.substr(start, tab - start)));
+        if (tab == std::string::npos)
+            return fields;
+        start = tab + 1;
+    }
+}
+
+std::string sanitize(const std::string& text)
+{
+    std::string result;
+    for (char c : text)
+        result += std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '-' ? c : '_';
+    return result;
+}
+} // namespace
+
+std::string DiagramStore::pathFor(const std::string& server, const std::string& schema)
+{
+    // Sanitizing can map different names to one file name, the hash of the exact names keeps them apart
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : server + '\0' + schema)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    char suffix[17];
+    std::snprintf(suffix, sizeof(suffix), "%08llx", static_cast<unsigned long long>(hash & 0xFFFFFFFFULL));
+
+    return (std::filesystem::path(DIRECTORY) / (sanitize(server) + "_" + sanitize(schema) + "_" + suffix + ".diagram")).string();
+}
+
+bool DiagramStore::save(const std::string& path, const Saved& saved)
+{
+    try
+    {
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+        // Written next to the target and renamed over it, a crash never leaves half a layout behind
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            if (!file.is_open())
+            {
+                LOG_ERROR("Cannot write diagram layout: " << temporary);
+                return false;
+            }
+
+            file.precision(9);
+            file << "diagram\t" << VERSION << '\n';
+            file << "fingerprint\t" << escape(saved.fingerprint) << '\n';
+            file << "view\t" << saved.zoom << '\t' << saved.pan.x << '\t' << saved.pan.y << '\n';
+
+            for (const auto& table : saved.tables)
+            {
+                file << "table\t" << escape(table.name) << '\t' << table.position.x << '\t' << table.position.y << '\n';
+                for (const auto& column : table.columns)
+                {
+                    file << "column\t" << escape(column.name) << '\t' << escape(column.type) << '\t' << column.isPrimaryKey << '\t'
+                         << column.isForeignKey << '\t' << escape(column.referencedTable) << '\t' << escape(column.referencedColumn)
+                         << '\n';
+                }
+            }
+
+            if (!file)
+            {
+                LOG_ERROR("Failed writing diagram layout: " << temporary);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path);
+        LOG_DEBUG("Saved diagram layout with " << saved.tables.size() << " tables to " << path);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Failed to save diagram layout " << path << ": " << e.what());
+        return false;
+    }
+}
+
+bool DiagramStore::load(const std::string& path, Saved& saved)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    try
+    {
+        Saved loaded;
+        std::string line;
+        bool versionSeen = false;
+
+        while (std::getline(file, line))
+        {
+            auto fields = splitFields(line);
+            const std::string& kind = fields[0];
+
+            if (kind == "diagram" && fields.size() >= 2)
+            {
+                if (std::stoi(fields[1]) != VERSION)
+                {
+                    LOG_WARNING("Ignoring diagram layout with version " << fields[1] << ": " << path);
+                    return false;
+                }
+                versionSeen = true;
+            }
+            else if (kind == "fingerprint" && fields.size() >= 2)
+            {
+                loaded.fingerprint = fields[1];
+            }
+            else if (kind == "view" && fields.size() >= 4)
+            {
+                loaded.zoom = std::stof(fields[1]);
+                loaded.pan = {std::stof(fields[2]), std::stof(fields[3])};
+            }
+            else if (kind == "table" && fields.size() >= 4)
+            {
+                Diagram::TableNode table;
+                table.name = fields[1];
+                table.position = {std::stof(fields[2]), std::stof(fields[3])};
+                loaded.tables.push_back(std::move(table));
+            }
+            else if (kind == "column" && fields.size() >= 7 && !loaded.tables.empty())
+            {
+                loaded.tables.back().columns.push_back(
+                    {fields[1], fields[2], fields[3] == "1", fields[4] == "1", fields[5], fields[6], ""});
+            }
+        }
+
+        if (!versionSeen)
+        {
+            LOG_WARNING("Not a diagram layout: " << path);
+            return false;
+        }
+
+        saved = std::move(loaded);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("Ignoring unreadable diagram layout " << path << ": " << e.what());
+        return false;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "DiagramTypes.h"
+
+#include <string>
+#include <vector>
+
+#include <raylib.h>
+
+// Tables, positions and view of one diagram in a text file per server and schema, so reopening it needs
+// neither the schema queries nor a new layout. The fingerprint says which schema version the tables came from.
+class DiagramStore
+{
+public:
+    struct Saved
+    {
+        std::string fingerprint;
+        std::vector<Diagram::TableNode> tables; // Names, columns and positions
+        float zoom = 1.0f;
+        Vector2 pan = {0, 0};
+    };
+
+public:
+    static std::string pathFor(const std::string& server, const std::string& schema);
+    static bool save(const std::string& path, const Saved& saved);
+    static bool load(const std::string& path, Saved& saved);
+
+public:
+    static constexpr int VERSION = 1;
+    static constexpr const char* DIRECTORY = "diagrams";
+};
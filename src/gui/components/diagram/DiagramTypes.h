@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <raylib.h>
@@ -15,12 +16,14 @@ struct TableColumn
     bool isForeignKey;
     std::string referencedTable;
     std::string referencedColumn;
+    std::string label; // Name with [PK]/[FK] markers, filled in by ERDiagram::addTable
 };
 
 struct TableNode
 {
     std::string name;
     std::vector<TableColumn> columns;
+    std::unordered_map<std::string, uint32_t> columnRows; // Column name to index, filled in by ERDiagram::addTable
     Vector2 position;
     Vector2 size;
     bool isSelected = false;
@@ -35,8 +38,27 @@ struct Relationship
     std::string toColumn;
 };
 
+// How much of the diagram is drawn, picked from the zoom so that only legible detail is paid for
+enum class DetailLevel
+{
+    OUTLINE, // Table boxes with names, straight edges
+    KEYS,    // Primary and foreign key columns, coarse curves
+    FULL     // Every column with its type, smooth curves
+};
+
 constexpr float TABLE_PADDING = 10.0f;
 constexpr float TABLE_HEADER_HEIGHT = 30.0f;
 constexpr float ROW_HEIGHT = 25.0f;
 constexpr float MIN_TABLE_WIDTH = 200.0f;
+
+// Below these zoom levels column text is smaller than about 6 and 9 pixels
+constexpr float KEYS_ZOOM = 0.4f;
+constexpr float FULL_ZOOM = 0.75f;
+
+inline DetailLevel detailLevel(float zoom)
+{
+    if (zoom < KEYS_ZOOM)
+        return DetailLevel::OUTLINE;
+    return zoom < FULL_ZOOM ? DetailLevel::KEYS : DetailLevel::FULL;
+}
 } // namespace Diagram
@@ -1,46 +1,72 @@
 #include "RelationshipRenderer.h"
 
+#include <algorithm>
 #include <cmath>
 
-void RelationshipRenderer::render(const Diagram::TableNode& from, const Diagram::TableNode& to, const std::string& fromCol,
-                                  const std::string& toCol, const Rectangle& bounds, const Vector2& pan, float zoom)
+void RelationshipRenderer::buildCurve(const Diagram::TableNode& from, int fromRow, const Diagram::TableNode& to, int toRow,
+                                      Curve& curve)
 {
-    float fromY = 0, toY = 0;
+    Vector2 start = anchor(from, fromRow);
+    start.x += from.size.x;
+    Vector2 end = anchor(to, toRow);
 
-    Vector2 fromPos = findColumnPosition(from, fromCol, fromY);
-    Vector2 toPos = findColumnPosition(to, toCol, toY);
+    float left = start.x, right = start.x, top = start.y, bottom = start.y;
+    for (int i = 0; i <= BEZIER_SEGMENTS; i++)
+    {
+        Vector2 point = calculateBezierPoint(start, end, i / static_cast<float>(BEZIER_SEGMENTS));
+        curve.points[i] = point;
+        left = std::min(left, point.x);
+        right = std::max(right, point.x);
+        top = std::min(top, point.y);
+        bottom = std::max(bottom, point.y);
+    }
 
-    Vector2 start = {bounds.x + (fromPos.x + from.size.x) * zoom + pan.x, bounds.y + fromPos.y * zoom + pan.y};
+    // The arrow head is sized in pixels, the margin covers it down to the lowest zoom that still draws it
+    float margin = ARROW_SIZE / Diagram::KEYS_ZOOM;
+    curve.bounds = Rectangle{left - margin, top - margin, right - left + margin * 2, bottom - top + margin * 2};
+}
 
-    Vector2 end = {bounds.x + toPos.x * zoom + pan.x, bounds.y + toPos.y * zoom + pan.y};
+void RelationshipRenderer::render(const Curve& curve, float zoom, Diagram::DetailLevel level)
+{
+    const auto& points = curve.points;
+    float thickness = std::max(2.0f, 1.0f / zoom);
 
-    Vector2 previous = start;
-    for (int i = 1; i <= BEZIER_SEGMENTS; i++)
+    // Tables are only a few pixels wide in the outline, a curve or an arrow head would not be visible
+    if (level == Diagram::DetailLevel::OUTLINE)
     {
-        float t = i / static_cast<float>(BEZIER_SEGMENTS);
-        Vector2 current = calculateBezierPoint(start, end, t);
-        DrawLineEx(previous, current, 2 * zoom, DARKGRAY);
-        previous = current;
+        DrawLineEx(points.front(), points.back(), thickness, DARKGRAY);
+        return;
     }
 
-    drawArrow(previous, end);
+    int stride = level == Diagram::DetailLevel::FULL ? 1 : COARSE_STRIDE;
+    for (int i = stride; i <= BEZIER_SEGMENTS; i += stride)
+        DrawLineEx(points[i - stride], points[i], thickness, DARKGRAY);
+
+    drawArrow(points[BEZIER_SEGMENTS - 1], points[BEZIER_SEGMENTS], ARROW_SIZE / zoom);
+}
+
+int RelationshipRenderer::columnRow(const Diagram::TableNode& table, const std::string& columnName)
+{
+    auto it = table.columnRows.find(columnName);
+    return it != table.columnRows.end() ? static_cast<int>(it->second) : -1;
 }
 
-void RelationshipRenderer::drawArrow(const Vector2& start, const Vector2& end)
+void RelationshipRenderer::drawArrow(const Vector2& start, const Vector2& end, float size)
 {
     Vector2 direction = {end.x - start.x, end.y - start.y};
 
     float length = sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length == 0)
+        return;
+
     direction.x /= length;
     direction.y /= length;
 
     Vector2 perpendicular = {-direction.y, direction.x};
 
-    Vector2 arrowPoint1 = {end.x - direction.x * ARROW_SIZE + perpendicular.x * ARROW_SIZE,
-                           end.y - direction.y * ARROW_SIZE + perpendicular.y * ARROW_SIZE};
+    Vector2 arrowPoint1 = {end.x - direction.x * size + perpendicular.x * size, end.y - direction.y * size + perpendicular.y * size};
 
-    Vector2 arrowPoint2 = {end.x - direction.x * ARROW_SIZE - perpendicular.x * ARROW_SIZE,
-                           end.y - direction.y * ARROW_SIZE - perpendicular.y * ARROW_SIZE};
+    Vector2 arrowPoint2 = {end.x - direction.x * size - perpendicular.x * size, end.y - direction.y * size - perpendicular.y * size};
 
     DrawTriangle(arrowPoint1, end, arrowPoint2, DARKGRAY);
 }
@@ -68,15 +94,11 @@ float RelationshipRenderer::calculateDistance(const Vector2& p1, const Vector2&
     return sqrt(dx * dx + dy * dy);
 }
 
-Vector2 RelationshipRenderer::findColumnPosition(const Diagram::TableNode& table, const std::string& columnName, float& yOffset)
+Vector2 RelationshipRenderer::anchor(const Diagram::TableNode& table, int row)
 {
-    for (size_t i = 0; i < table.columns.size(); i++)
-    {
-        if (table.columns[i].name == columnName)
-        {
-            float y = (i + 1) * ROW_HEIGHT + TABLE_HEADER_HEIGHT - (ROW_HEIGHT / 2);
-            return {table.position.x, table.position.y + y};
-        }
-    }
-    return {table.position.x, table.position.y + yOffset};
+    if (row < 0)
+        return table.position;
+
+    float y = (row + 1) * ROW_HEIGHT + TABLE_HEADER_HEIGHT - (ROW_HEIGHT / 2);
+    return {table.position.x, table.position.y + y};
 }
@@ -2,23 +2,42 @@
 
 #include "DiagramTypes.h"
 
+#include <array>
+
 #include <raylib.h>
 
 class RelationshipRenderer
 {
 public:
-    static void render(const Diagram::TableNode& from, const Diagram::TableNode& to, const std::string& fromCol,
-                       const std::string& toCol, const Rectangle& bounds, const Vector2& pan, float zoom);
+    // Sampled curve in diagram coordinates, rebuilt only when one of its tables moves
+    struct Curve
+    {
+        std::array<Vector2, 21> points;
+        Rectangle bounds; // Points and arrow head, for spatial indexing
+    };
+
+public:
+    // Rows are column indices from Diagram::TableNode::columnRows, -1 anchors at the table's top corner
+    static void buildCurve(const Diagram::TableNode& from, int fromRow, const Diagram::TableNode& to, int toRow, Curve& curve);
+
+    // Draws in diagram coordinates, the caller sets up the pan and zoom transform
+    static void render(const Curve& curve, float zoom, Diagram::DetailLevel level);
+
+    static int columnRow(const Diagram::TableNode& table, const std::string& columnName);
 
 private:
-    static void drawArrow(const Vector2& start, const Vector2& end);
+    static void drawArrow(const Vector2& start, const Vector2& end, float size);
     static Vector2 calculateBezierPoint(const Vector2& start, const Vector2& end, float t);
     static float calculateDistance(const Vector2& p1, const Vector2& p2);
-    static Vector2 findColumnPosition(const Diagram::TableNode& table, const std::string& columnName, float& yOffset);
+    static Vector2 anchor(const Diagram::TableNode& table, int row);
 
 private:
     static constexpr float ARROW_SIZE = 8.0f;
     static constexpr int BEZIER_SEGMENTS = 20;
+    static constexpr int COARSE_STRIDE = 4; // Every fourth point, 5 segments
     static constexpr float TABLE_HEADER_HEIGHT = Diagram::TABLE_HEADER_HEIGHT;
     static constexpr float ROW_HEIGHT = Diagram::ROW_HEIGHT;
+
+    static_assert(BEZIER_SEGMENTS % COARSE_STRIDE == 0, "coarse curves must end on the last point");
+    static_assert(std::tuple_size<decltype(Curve::points)>::value == BEZIER_SEGMENTS + 1, "one point per segment end");
 };
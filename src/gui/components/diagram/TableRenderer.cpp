@@ -1,13 +1,22 @@
 #include "TableRenderer.h"
+#include "../TextLayoutCache.h"
 
 #include <algorithm>
 
-void TableRenderer::render(const Diagram::TableNode& table, const Rectangle& bounds, const Vector2& pan, float zoom)
+void TableRenderer::render(const Diagram::TableNode& table, const Rectangle& bounds, const Vector2& pan, float zoom,
+                           Diagram::DetailLevel level)
 {
     Vector2 pos = {bounds.x + table.position.x * zoom + pan.x, bounds.y + table.position.y * zoom + pan.y};
 
     Rectangle tableRect = {pos.x, pos.y, table.size.x * zoom, table.size.y * zoom};
 
+    if (level == Diagram::DetailLevel::OUTLINE)
+    {
+        drawOutline(table.name, tableRect);
+        DrawRectangleLinesEx(tableRect, 1, table.isSelected ? BLUE : DARKGRAY);
+        return;
+    }
+
     DrawRectangleRec(tableRect, WHITE);
     DrawRectangleLinesEx(tableRect, 1, table.isSelected ? BLUE : DARKGRAY);
 
@@ -15,7 +24,20 @@ void TableRenderer::render(const Diagram::TableNode& table, const Rectangle& bou
     drawHeader(table.name, headerRect);
 
     Rectangle contentRect = {tableRect.x, headerRect.y + headerRect.height, tableRect.width, tableRect.height - headerRect.height};
-    drawColumns(table.columns, contentRect, ROW_HEIGHT * zoom);
+    drawColumns(table.columns, contentRect, ROW_HEIGHT * zoom, level == Diagram::DetailLevel::KEYS);
+}
+
+void TableRenderer::drawOutline(const std::string& name, const Rectangle& tableRect)
+{
+    DrawRectangleRec(tableRect, Color{230, 230, 230, 255});
+
+    // The header would be a few pixels high here, so the name gets a fixed size across the whole box instead
+    const auto& label = TextLayoutCache::fit(name, tableRect.width - 4, OUTLINE_FONT_SIZE);
+    if (label.display.empty() || tableRect.height < OUTLINE_FONT_SIZE)
+        return;
+
+    DrawText(label.display.c_str(), static_cast<int>(tableRect.x + (tableRect.width - label.displayWidth) / 2),
+             static_cast<int>(tableRect.y + (std::min(tableRect.height, 40.0f) - OUTLINE_FONT_SIZE) / 2), OUTLINE_FONT_SIZE, DARKGRAY);
 }
 
 void TableRenderer::drawHeader(const std::string& name, const Rectangle& headerRect)
@@ -30,16 +52,21 @@ void TableRenderer::drawHeader(const std::string& name, const Rectangle& headerR
     DrawTextEx(GetFontDefault(), name.c_str(), textPos, fontSize, 1, DARKGRAY);
 }
 
-void TableRenderer::drawColumns(const std::vector<Diagram::TableColumn>& columns, const Rectangle& contentRect, float rowHeight)
+void TableRenderer::drawColumns(const std::vector<Diagram::TableColumn>& columns, const Rectangle& contentRect, float rowHeight,
+                                bool keysOnly)
 {
     float yOffset = contentRect.y;
     float fontSize = std::min(14.0f, rowHeight * 0.6f);
     float padding = TABLE_PADDING;
 
+    // Key columns keep their own rows so relationship lines still end at them
     for (const auto& column : columns)
     {
-        Rectangle rowRect = {contentRect.x, yOffset, contentRect.width, rowHeight};
-        drawColumn(column, rowRect, fontSize, padding);
+        if (!keysOnly || column.isPrimaryKey || column.isForeignKey)
+        {
+            Rectangle rowRect = {contentRect.x, yOffset, contentRect.width, rowHeight};
+            drawColumn(column, rowRect, fontSize, padding);
+        }
         yOffset += rowHeight;
     }
 }
@@ -49,44 +76,19 @@ void TableRenderer::drawColumn(const Diagram::TableColumn& column, const Rectang
     DrawRectangleRec(rowRect, WHITE);
     DrawRectangleLinesEx(rowRect, 1, Color{230, 230, 230, 255});
 
-    std::string columnText = column.name;
-    if (column.isPrimaryKey)
-        columnText = "[PK] " + columnText;
-    if (column.isForeignKey)
-        columnText = "[FK] " + columnText;
-
+    // Truncated text comes from the layout cache, so an unchanged diagram does no string work
     float availableWidth = rowRect.width - (padding * 3);
     float maxNameWidth = availableWidth * 0.7f;
     float maxTypeWidth = availableWidth * 0.3f;
+    int typeFontSize = static_cast<int>(fontSize * 0.9f);
 
-    std::string displayText = columnText;
-    float textWidth = MeasureText(displayText.c_str(), fontSize);
-    if (textWidth > maxNameWidth)
-    {
-        while (textWidth > maxNameWidth - MeasureText("...", fontSize))
-        {
-            displayText = displayText.substr(0, displayText.length() - 1);
-            textWidth = MeasureText(displayText.c_str(), fontSize);
-        }
-        displayText += "...";
-    }
-
-    DrawTextEx(GetFontDefault(), displayText.c_str(), {rowRect.x + padding, rowRect.y + (rowRect.height - fontSize) / 2}, fontSize, 1,
+    const auto& name = TextLayoutCache::fit(column.label, maxNameWidth, static_cast<int>(fontSize));
+    DrawTextEx(GetFontDefault(), name.display.c_str(), {rowRect.x + padding, rowRect.y + (rowRect.height - fontSize) / 2}, fontSize, 1,
                column.isPrimaryKey ? DARKBLUE : DARKGRAY);
 
-    std::string typeText = column.type;
-    float typeTextWidth = MeasureText(typeText.c_str(), fontSize * 0.9f);
-    if (typeTextWidth > maxTypeWidth)
-    {
-        while (typeTextWidth > maxTypeWidth - MeasureText("...", fontSize * 0.9f))
-        {
-            typeText = typeText.substr(0, typeText.length() - 1);
-            typeTextWidth = MeasureText(typeText.c_str(), fontSize * 0.9f);
-        }
-        typeText += "...";
-    }
-
-    DrawTextEx(GetFontDefault(), typeText.c_str(),
+    const auto& type = TextLayoutCache::fit(column.type, maxTypeWidth, typeFontSize);
+    float typeTextWidth = type.displayWidth;
+    DrawTextEx(GetFontDefault(), type.display.c_str(),
                {rowRect.x + rowRect.width - typeTextWidth - padding, rowRect.y + (rowRect.height - fontSize) / 2}, fontSize * 0.9f, 1,
                GRAY);
 }
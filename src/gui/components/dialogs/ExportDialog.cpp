@@ -1,12 +1,13 @@
 #include "ExportDialog.h"
 
+#include "../../../core/logging/Logger.h"
+
 #include <cstring>
-#include <iostream>
 
 #include "../include/raygui.h"
 
 ExportDialog::ExportDialog()
-    : Dialog("Export Database", 450, 250)
+    : Dialog("Export Database", 450, 370)
 {
     resetState();
 }
@@ -15,11 +16,11 @@ void ExportDialog::render()
 {
     if (!visible)
     {
-        std::cout << "ExportDialog::render - dialog not visible" << std::endl;
+        LOG_TRACE("ExportDialog::render - dialog not visible");
         return;
     }
 
-    std::cout << "ExportDialog::render - rendering dialog" << std::endl;
+    LOG_TRACE("ExportDialog::render - rendering dialog");
     Dialog::render(); 
 
     Rectangle contentBounds = calculateDialogBounds();
@@ -29,9 +30,9 @@ void ExportDialog::render()
 
 void ExportDialog::show()
 {
-    std::cout << "ExportDialog::show called" << std::endl;
+    LOG_DEBUG("ExportDialog::show called");
     visible = true;
-    std::cout << "Visibility after show: " << visible << std::endl;
+    LOG_DEBUG("Visibility after show: " << visible);
 }
 
 void ExportDialog::showWithDatabase(const std::string& dbName)
@@ -42,10 +43,10 @@ void ExportDialog::showWithDatabase(const std::string& dbName)
 
 void ExportDialog::hide()
 {
-    std::cout << "ExportDialog::hide called" << std::endl;
+    LOG_DEBUG("ExportDialog::hide called");
     visible = false;
     resetState();
-    std::cout << "Visibility after hide: " << visible << std::endl;
+    LOG_DEBUG("Visibility after hide: " << visible);
 }
 
 void ExportDialog::renderInputFields()
@@ -68,6 +69,7 @@ void ExportDialog::renderInputFields()
     {
         filenameActive = !filenameActive;
         pathActive = false;
+        baseExportActive = false;
     }
 
     y += inputHeight + spacing;
@@ -79,6 +81,54 @@ void ExportDialog::renderInputFields()
     {
         pathActive = !pathActive;
         filenameActive = false;
+        baseExportActive = false;
+    }
+
+    y += inputHeight + spacing;
+    DrawText("Format:", contentBounds.x, y, 14, DARKGRAY);
+    y += labelHeight;
+
+    renderFormatToggle(Rectangle{contentBounds.x, y, inputWidth, inputHeight});
+
+    if (format != Format::DIRECTORY)
+        return;
+
+    y += inputHeight + spacing;
+    DrawText("Base export for incremental mode (optional):", contentBounds.x, y, 14, DARKGRAY);
+    y += labelHeight;
+
+    DrawRectangleRec(Rectangle{contentBounds.x, y, inputWidth, inputHeight}, WHITE);
+    if (GuiTextBox(Rectangle{contentBounds.x, y, inputWidth, inputHeight}, baseExport, 512, baseExportActive))
+    {
+        baseExportActive = !baseExportActive;
+        filenameActive = false;
+        pathActive = false;
+    }
+}
+
+void ExportDialog::renderFormatToggle(Rectangle area)
+{
+    const char* labels[] = {"Single .sql file", "Directory + manifest"};
+    const Format formats[] = {Format::SQL_FILE, Format::DIRECTORY};
+    float segmentWidth = area.width / 2;
+
+    for (int i = 0; i < 2; i++)
+    {
+        Rectangle segment = {area.x + segmentWidth * i, area.y, segmentWidth, area.height};
+        bool selected = format == formats[i];
+        bool hovered = CheckCollisionPointRec(GetMousePosition(), segment);
+
+        if (hovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        {
+            format = formats[i];
+            selected = true;
+        }
+
+        Color background = hovered ? Color{225, 225, 225, 255} : Color{240, 240, 240, 255};
+        DrawRectangleRec(segment, selected ? Color{0, 120, 210, 255} : background);
+        DrawRectangleLinesEx(segment, 1, Color{200, 200, 200, 255});
+        DrawText(labels[i], segment.x + (segment.width - MeasureText(labels[i], 14)) / 2, segment.y + (segment.height - 14) / 2, 14,
+                 selected ? WHITE : DARKGRAY);
     }
 }
 
@@ -114,13 +164,13 @@ void ExportDialog::handleInput()
 {
     if (!visible)
     {
-        std::cout << "ExportDialog::handleInput - dialog not visible" << std::endl;
+        LOG_TRACE("ExportDialog::handleInput - dialog not visible");
         return;
     }
 
     if (IsKeyPressed(KEY_ESCAPE))
     {
-        std::cout << "ExportDialog::handleInput - ESC pressed" << std::endl;
+        LOG_DEBUG("ExportDialog::handleInput - ESC pressed");
         hide();
         return;
     }
@@ -137,41 +187,35 @@ void ExportDialog::handleInput()
     Rectangle cancelBtnRect = {bounds.x + bounds.width - buttonWidth - PADDING,
                                bounds.y + bounds.height - buttonHeight - bottomPadding, buttonWidth, buttonHeight};
 
-    std::cout << "\n=== Export Button Debug ===" << std::endl;
-    std::cout << "Mouse position: " << mousePos.x << ", " << mousePos.y << std::endl;
-    std::cout << "Export button bounds: " << exportBtnRect.x << ", " << exportBtnRect.y << ", " << exportBtnRect.width << ", "
-              << exportBtnRect.height << std::endl;
+    LOG_TRACE("Export button " << exportBtnRect.x << ", " << exportBtnRect.y << ", " << exportBtnRect.width << "x"
+                               << exportBtnRect.height << ", mouse " << mousePos.x << ", " << mousePos.y);
 
     bool overExport = CheckCollisionPointRec(mousePos, exportBtnRect);
     bool overCancel = CheckCollisionPointRec(mousePos, cancelBtnRect);
     bool clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
 
-    std::cout << "Over export button: " << overExport << std::endl;
-    std::cout << "Over cancel button: " << overCancel << std::endl;
-    std::cout << "Mouse clicked: " << clicked << std::endl;
-    std::cout << "Export callback set: " << (onExport ? "yes" : "no") << std::endl;
+    LOG_TRACE("Over export: " << overExport << ", over cancel: " << overCancel << ", clicked: " << clicked
+                              << ", callback set: " << (onExport ? "yes" : "no"));
 
     if (clicked)
     {
         if (overExport)
         {
-            std::cout << "Export button clicked" << std::endl;
+            LOG_DEBUG("Export button clicked");
             if (onExport)
             {
-                std::cout << "Calling export callback with:" << std::endl;
-                std::cout << "Path: " << path << std::endl;
-                std::cout << "Filename: " << filename << std::endl;
-                onExport(path, filename);
+                LOG_DEBUG("Calling export callback with path " << path << ", filename " << filename);
+                onExport(path, filename, format, format == Format::DIRECTORY ? baseExport : "");
             }
             else
             {
-                std::cout << "Warning: Export callback is not set!" << std::endl;
+                LOG_WARNING("Export callback is not set");
             }
             hide();
         }
         else if (overCancel)
         {
-            std::cout << "Cancel button clicked" << std::endl;
+            LOG_DEBUG("Cancel button clicked");
             hide();
         }
     }
@@ -184,4 +228,7 @@ void ExportDialog::resetState()
 
     filenameActive = false;
     pathActive = false;
+    format = Format::SQL_FILE;
+    baseExport[0] = '\0';
+    baseExportActive = false;
 }
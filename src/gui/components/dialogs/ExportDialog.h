@@ -18,12 +18,20 @@ public:
 public:
     void showWithDatabase(const std::string& dbName);
 
-    using ExportCallback = std::function<void(const std::string&, const std::string&)>;
+    enum class Format
+    {
+        SQL_FILE,
+        DIRECTORY
+    };
+
+    // path, filename, format and the base export for incremental directory exports (may be empty)
+    using ExportCallback = std::function<void(const std::string&, const std::string&, Format, const std::string&)>;
     void setExportCallback(ExportCallback callback) { onExport = callback; }
 
 private:
     void renderInputFields();
     void renderButtons();
+    void renderFormatToggle(Rectangle area);
     void resetState();
 
 private:
@@ -31,6 +39,9 @@ private:
     char path[512] = "exports/";
     bool filenameActive = false;
     bool pathActive = false;
+    char baseExport[512] = "";
+    bool baseExportActive = false;
+    Format format = Format::SQL_FILE;
 
     ExportCallback onExport;
 };
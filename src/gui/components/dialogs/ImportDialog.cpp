@@ -1,12 +1,13 @@
 #include "ImportDialog.h"
 
+#include "../../../core/logging/Logger.h"
+
 #include <cstring>
-#include <iostream>
 
 #include "../include/raygui.h"
 
 ImportDialog::ImportDialog()
-    : Dialog("Import Database", 450, 200) 
+    : Dialog("Import Database", 450, 270)
 {
     resetState();
 }
@@ -15,11 +16,11 @@ void ImportDialog::render()
 {
     if (!visible)
     {
-        std::cout << "ImportDialog not visible, skipping render" << std::endl;
+        LOG_TRACE("ImportDialog not visible, skipping render");
         return;
     }
 
-    std::cout << "Rendering ImportDialog" << std::endl;
+    LOG_TRACE("Rendering ImportDialog");
     Dialog::render();
 
     Rectangle contentBounds = calculateDialogBounds();
@@ -36,15 +37,31 @@ void ImportDialog::renderInputFields()
     float inputWidth = contentBounds.width - PADDING * 2;
     float inputHeight = 30;
     float labelHeight = 15;
+    float spacing = 20;
 
     float y = contentBounds.y + 10;
-    DrawText("SQL File Path:", contentBounds.x, y, 14, DARKGRAY);
+    DrawText("File Path (.sql, .csv, .tsv or export directory):", contentBounds.x, y, 14, DARKGRAY);
     y += labelHeight;
 
     DrawRectangleRec(Rectangle{contentBounds.x, y, inputWidth, inputHeight}, WHITE);
 
     if (GuiTextBox(Rectangle{contentBounds.x, y, inputWidth, inputHeight}, path, 512, pathActive))
+    {
         pathActive = !pathActive;
+        tableActive = false;
+    }
+
+    y += inputHeight + spacing;
+    DrawText("Target Table (schema.table for CSV/TSV, or an exported table):", contentBounds.x, y, 14, DARKGRAY);
+    y += labelHeight;
+
+    DrawRectangleRec(Rectangle{contentBounds.x, y, inputWidth, inputHeight}, WHITE);
+
+    if (GuiTextBox(Rectangle{contentBounds.x, y, inputWidth, inputHeight}, tableName, 128, tableActive))
+    {
+        tableActive = !tableActive;
+        pathActive = false;
+    }
 }
 
 void ImportDialog::renderButtons()
@@ -63,14 +80,19 @@ void ImportDialog::renderButtons()
     Rectangle cancelBtnRect = {bounds.x + bounds.width - buttonWidth - PADDING,
                                bounds.y + bounds.height - buttonHeight - bottomPadding, buttonWidth, buttonHeight};
 
+    Rectangle verifyBtnRect = {importBtnRect.x - buttonWidth - spacing, importBtnRect.y, buttonWidth, buttonHeight};
+
     bool importHovered = CheckCollisionPointRec(GetMousePosition(), importBtnRect);
     bool cancelHovered = CheckCollisionPointRec(GetMousePosition(), cancelBtnRect);
+    bool verifyHovered = CheckCollisionPointRec(GetMousePosition(), verifyBtnRect);
 
     DrawRectangleRounded(importBtnRect, 0.2f, 8, importHovered ? Color{0, 100, 180, 255} : Color{0, 120, 210, 255});
     DrawRectangleRounded(cancelBtnRect, 0.2f, 8, cancelHovered ? Color{180, 180, 180, 255} : Color{200, 200, 200, 255});
+    DrawRectangleRounded(verifyBtnRect, 0.2f, 8, verifyHovered ? Color{180, 180, 180, 255} : Color{200, 200, 200, 255});
 
     DrawText("Import", importBtnRect.x + (importBtnRect.width - MeasureText("Import", 18)) / 2, importBtnRect.y + 7, 18, WHITE);
     DrawText("Cancel", cancelBtnRect.x + (cancelBtnRect.width - MeasureText("Cancel", 18)) / 2, cancelBtnRect.y + 7, 18, DARKGRAY);
+    DrawText("Verify", verifyBtnRect.x + (verifyBtnRect.width - MeasureText("Verify", 18)) / 2, verifyBtnRect.y + 7, 18, DARKGRAY);
 
     handleInput();
 }
@@ -101,34 +123,43 @@ void ImportDialog::handleInput()
     Rectangle cancelBtnRect = {bounds.x + bounds.width - buttonWidth - PADDING,
                                bounds.y + bounds.height - buttonHeight - bottomPadding, buttonWidth, buttonHeight};
 
+    Rectangle verifyBtnRect = {importBtnRect.x - buttonWidth - spacing, importBtnRect.y, buttonWidth, buttonHeight};
+
     if (CheckCollisionPointRec(mousePos, importBtnRect))
     {
-        std::cout << "Import button clicked in dialog" << std::endl;
+        LOG_DEBUG("Import button clicked in dialog");
 
         if (onImport)
-            onImport(path);
+            onImport(path, tableName);
 
         hide();
     }
     else if (CheckCollisionPointRec(mousePos, cancelBtnRect))
     {
-        std::cout << "Cancel button clicked in dialog" << std::endl;
+        LOG_DEBUG("Cancel button clicked in dialog");
+        hide();
+    }
+    else if (CheckCollisionPointRec(mousePos, verifyBtnRect))
+    {
+        if (onVerify)
+            onVerify(path);
+
         hide();
     }
 }
 
 void ImportDialog::show()
 {
-    std::cout << "ImportDialog::show called" << std::endl;
+    LOG_DEBUG("ImportDialog::show called");
     Dialog::show(); 
     visible = true;
     resetState();
-    std::cout << "Dialog visibility after show: " << visible << std::endl;
+    LOG_DEBUG("Dialog visibility after show: " << visible);
 }
 
 void ImportDialog::hide()
 {
-    std::cout << "ImportDialog::hide called" << std::endl;
+    LOG_DEBUG("ImportDialog::hide called");
     visible = false;
     resetState();
 }
@@ -136,5 +167,7 @@ void ImportDialog::hide()
 void ImportDialog::resetState()
 {
     strcpy(path, "imports/");
+    tableName[0] = '\0';
     pathActive = false;
+    tableActive = false;
 }
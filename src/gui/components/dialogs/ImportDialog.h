@@ -10,16 +10,23 @@ public:
     void hide() override;
     void show() override;
 
-    using ImportCallback = std::function<void(const std::string&)>;
+    using ImportCallback = std::function<void(const std::string&, const std::string&)>;
     void setImportCallback(ImportCallback callback) { onImport = callback; }
 
+    // Checks a restored database against a directory export without importing anything
+    using VerifyCallback = std::function<void(const std::string&)>;
+    void setVerifyCallback(VerifyCallback callback) { onVerify = callback; }
+
 private:
     void renderInputFields();
     void renderButtons();
     void resetState();
 
     char path[512] = "imports/";
+    char tableName[128] = "";
     bool pathActive = false;
+    bool tableActive = false;
 
     ImportCallback onImport;
+    VerifyCallback onVerify;
 }; 
\ No newline at end of file
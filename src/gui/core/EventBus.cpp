@@ -1,6 +1,10 @@
 #include "EventBus.h"
+#include "FramePacer.h"
+#include "../../core/logging/Logger.h"
 
-#include <iostream>
+#include <algorithm>
+
+thread_local std::vector<const EventBus::Liveness*> EventBus::s_running;
 
 EventBus& EventBus::getInstance()
 {
@@ -8,45 +12,102 @@ EventBus& EventBus::getInstance()
     return instance;
 }
 
-EventBus::SubscriberId EventBus::subscribe(EventType type, EventCallback callback)
+EventBus::SubscriberId EventBus::add(EventType type, Handler callback)
 {
     std::lock_guard<std::mutex> lock(m_subscribersMutex);
-    static SubscriberId nextId = 0;
-    SubscriberId id = nextId++;
-    m_subscribers[type].push_back({id, std::move(callback)});
+    SubscriberId id = m_nextId++;
+
+    auto& current = m_subscribers[type];
+    auto subs = current ? std::make_shared<SubscriberList>(*current) : std::make_shared<SubscriberList>();
+    subs->push_back({id, std::move(callback), std::make_shared<Liveness>()});
+    current = std::move(subs);
     return id;
 }
 
 void EventBus::unsubscribe(EventType type, SubscriberId id)
 {
-    std::lock_guard<std::mutex> lock(m_subscribersMutex);
-    if (auto it = m_subscribers.find(type); it != m_subscribers.end())
+    std::shared_ptr<Liveness> liveness;
     {
-        auto& subs = it->second;
-        subs.erase(std::remove_if(subs.begin(), subs.end(),
-                                  [id](const auto& sub) {
-                                      return sub.id == id;
-                                  }),
-                   subs.end());
+        std::lock_guard<std::mutex> lock(m_subscribersMutex);
+        auto it = m_subscribers.find(type);
+        if (it == m_subscribers.end() || !it->second)
+            return;
+
+        auto subs = std::make_shared<SubscriberList>(*it->second);
+        auto removed = std::find_if(subs->begin(), subs->end(),
+                                    [id](const auto& sub) {
+                                        return sub.id == id;
+                                    });
+        if (removed == subs->end())
+            return;
+
+        liveness = removed->liveness;
+        subs->erase(removed);
+        it->second = std::move(subs);
     }
+
+    // A dispatch may still hold the old list, the flag stops it from calling this subscriber from now on
+    liveness->alive = false;
+
+    int own = static_cast<int>(std::count(s_running.begin(), s_running.end(), liveness.get()));
+    std::unique_lock<std::mutex> lock(liveness->mutex);
+    liveness->finished.wait(lock, [&]() { return liveness->inFlight.load() <= own; });
 }
 
-void EventBus::publish(EventType type, const std::any& data)
+void EventBus::dispatch(EventType type, const void* data)
 {
-    std::lock_guard<std::mutex> lock(m_subscribersMutex);
-    if (auto it = m_subscribers.find(type); it != m_subscribers.end())
+    // Anything published changes what is on screen, including results handed over from worker threads
+    FramePacer::wake();
+
+    std::shared_ptr<const SubscriberList> subs;
+    {
+        std::lock_guard<std::mutex> lock(m_subscribersMutex);
+        if (auto it = m_subscribers.find(type); it != m_subscribers.end())
+            subs = it->second;
+    }
+    if (!subs)
+        return;
+
+    // Callbacks may subscribe, unsubscribe or publish themselves, this pass keeps the list it started with
+    for (const auto& sub : *subs)
     {
-        auto subs = it->second;
-        for (const auto& sub : subs)
+        Liveness& liveness = *sub.liveness;
+
+        liveness.inFlight++;
+        if (!liveness.alive)
         {
-            try
-            {
-                sub.callback(data);
-            }
-            catch (const std::exception& e)
-            {
-                std::cerr << "Error in event callback: " << e.what() << std::endl;
-            }
+            finishCall(liveness);
+            continue;
         }
+
+        s_running.push_back(&liveness);
+        try
+        {
+            sub.callback(data);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Error in event callback: " << e.what());
+        }
+        catch (...)
+        {
+            s_running.pop_back();
+            finishCall(liveness);
+            throw;
+        }
+        s_running.pop_back();
+        finishCall(liveness);
+    }
+}
+
+void EventBus::finishCall(Liveness& liveness)
+{
+    liveness.inFlight--;
+
+    // Taking the mutex orders the notify after the waiter's check, so the wakeup cannot be lost
+    if (!liveness.alive)
+    {
+        std::lock_guard<std::mutex> lock(liveness.mutex);
+        liveness.finished.notify_all();
     }
 }
@@ -1,25 +1,47 @@
 #pragma once
 
+#include "EventData.h"
 #include "EventType.h"
 
-#include <any>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
 
+// Subscribers and publishers agree on the payload of every event at compile time through EventTraits. Payloads
+// are handed to the callbacks by reference, and the subscriber list is copied on write so publishing only takes
+// a reference to the current list and runs the callbacks without holding any lock.
 class EventBus
 {
 public:
-    using EventCallback = std::function<void(const std::any&)>;
     using SubscriberId = size_t;
 
+    template <EventType Type>
+    using Payload = typename EventTraits<Type>::Data;
+
+    template <EventType Type>
+    using Callback = std::function<void(const Payload<Type>&)>;
+
     static EventBus& getInstance();
 
-    SubscriberId subscribe(EventType type, EventCallback callback);
+    template <EventType Type>
+    SubscriberId subscribe(Callback<Type> callback)
+    {
+        return add(Type, [callback = std::move(callback)](const void* data) { callback(*static_cast<const Payload<Type>*>(data)); });
+    }
+
+    // Once this returns the callback is not called again. Calls still running on other threads are waited for,
+    // so it must not be called while holding anything those callbacks wait on; a callback may unsubscribe itself.
     void unsubscribe(EventType type, SubscriberId id);
-    void publish(EventType type, const std::any& data);
+
+    template <EventType Type>
+    void publish(const Payload<Type>& data = {})
+    {
+        dispatch(Type, &data);
+    }
 
 private:
     EventBus() = default;
@@ -27,12 +49,37 @@ private:
     EventBus(const EventBus&) = delete;
     EventBus& operator=(const EventBus&) = delete;
 
+    // Only ever called with a payload of the type the subscription was made for, both sides go through Payload<Type>
+    using Handler = std::function<void(const void*)>;
+
+    // Dispatch counts a call in before checking alive, unsubscribe clears alive before counting the calls left,
+    // so every call either sees the flag or is waited for. The mutex only guards the wait, never a callback.
+    struct Liveness
+    {
+        std::atomic<bool> alive{true};
+        std::atomic<int> inFlight{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
     struct Subscription
     {
         SubscriberId id;
-        EventCallback callback;
+        Handler callback;
+        std::shared_ptr<Liveness> liveness;
     };
 
-    std::unordered_map<EventType, std::vector<Subscription>> m_subscribers;
+    using SubscriberList = std::vector<Subscription>;
+
+    SubscriberId add(EventType type, Handler callback);
+    void dispatch(EventType type, const void* data);
+    static void finishCall(Liveness& liveness);
+
+    // Lists are never modified once published, subscribe and unsubscribe swap in a changed copy
+    std::unordered_map<EventType, std::shared_ptr<const SubscriberList>> m_subscribers;
     std::mutex m_subscribersMutex;
+    SubscriberId m_nextId = 0;
+
+    // Subscriptions whose callbacks are running on this thread, innermost last
+    static thread_local std::vector<const Liveness*> s_running;
 };
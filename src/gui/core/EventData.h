@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EventType.h"
 #include "../../models/QueryResult.h"
 
 #include <string>
@@ -17,18 +18,41 @@ struct DatabaseConnectedData
     }
 };
 
+// The result stays the publisher's, it is only valid during the callback. Subscribers keeping it take a copy,
+// which shares the row pages; the payload itself cannot be copied so it cannot outlive the result by accident.
 struct QueryExecutedData
 {
-    QueryResult result;
+    const QueryResult& result;
     bool success;
     std::string error;
 
-    QueryExecutedData(QueryResult res, bool succ, std::string err = "")
-        : result(std::move(res))
+    QueryExecutedData(const QueryResult& res, bool succ, std::string err = "")
+        : result(res)
         , success(succ)
         , error(std::move(err))
     {
     }
+
+    QueryExecutedData(const QueryExecutedData&) = delete;
+    QueryExecutedData& operator=(const QueryExecutedData&) = delete;
+};
+
+// Further pages of a result already announced by QueryExecuted. The result shares its pages with the
+// earlier event, rows before firstRow are unchanged. Like QueryExecutedData it refers to the publisher's result
+// and is only valid during the callback.
+struct QueryRowsAppendedData
+{
+    const QueryResult& result;
+    size_t firstRow;
+
+    QueryRowsAppendedData(const QueryResult& res, size_t first)
+        : result(res)
+        , firstRow(first)
+    {
+    }
+
+    QueryRowsAppendedData(const QueryRowsAppendedData&) = delete;
+    QueryRowsAppendedData& operator=(const QueryRowsAppendedData&) = delete;
 };
 
 struct TablesLoadedData
@@ -66,16 +90,53 @@ struct ErrorData
     }
 };
 
+// Refers to the publisher's result, only valid during the callback
 struct TableStructureData
 {
     std::string tableName;
-    QueryResult structure;
+    const QueryResult& structure;
     bool success;
 
-    TableStructureData(std::string name, QueryResult res, bool succ)
+    TableStructureData(std::string name, const QueryResult& res, bool succ)
         : tableName(std::move(name))
-        , structure(std::move(res))
+        , structure(res)
         , success(succ)
     {
     }
+
+    TableStructureData(const TableStructureData&) = delete;
+    TableStructureData& operator=(const TableStructureData&) = delete;
 };
+
+// Events that only signal a change
+struct NoEventData
+{
+};
+
+// Payload type of every event, publishing or subscribing to an event without an entry here does not compile
+template <EventType Type>
+struct EventTraits;
+
+#define EVENT_PAYLOAD(type, data) \
+    template <>                   \
+    struct EventTraits<type>      \
+    {                             \
+        using Data = data;        \
+    }
+
+EVENT_PAYLOAD(EventType::ServerConnected, DatabaseConnectedData);
+EVENT_PAYLOAD(EventType::ServerDisconnected, NoEventData);
+EVENT_PAYLOAD(EventType::DatabaseConnected, DatabaseConnectedData);
+EVENT_PAYLOAD(EventType::DatabaseDisconnected, NoEventData);
+EVENT_PAYLOAD(EventType::QueryExecuted, QueryExecutedData);
+EVENT_PAYLOAD(EventType::QueryRowsAppended, QueryRowsAppendedData);
+EVENT_PAYLOAD(EventType::QueryFailed, ErrorData);
+EVENT_PAYLOAD(EventType::TablesLoaded, TablesLoadedData);
+EVENT_PAYLOAD(EventType::ExportCompleted, ErrorData);
+EVENT_PAYLOAD(EventType::ExportFailed, ErrorData);
+EVENT_PAYLOAD(EventType::ErrorOccurred, ErrorData);
+EVENT_PAYLOAD(EventType::StateReset, NoEventData);
+EVENT_PAYLOAD(EventType::TableStructureLoaded, TableStructureData);
+EVENT_PAYLOAD(EventType::ImportCompleted, ErrorData);
+
+#undef EVENT_PAYLOAD
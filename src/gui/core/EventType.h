@@ -7,6 +7,7 @@ enum class EventType
     DatabaseConnected,
     DatabaseDisconnected,
     QueryExecuted,
+    QueryRowsAppended,
     QueryFailed,
     TablesLoaded,
     ExportCompleted,
@@ -0,0 +1,33 @@
+#include "FramePacer.h"
+
+#include <GLFW/glfw3.h>
+#include <raylib.h>
+
+std::atomic<int> FramePacer::pendingFrames{SETTLE_FRAMES};
+bool FramePacer::waiting = false;
+
+void FramePacer::wake(int frames)
+{
+    int current = pendingFrames.load();
+    while (current < frames && !pendingFrames.compare_exchange_weak(current, frames))
+    {
+    }
+
+    // Breaks a blocked event wait on the main thread, harmless if the loop is already running
+    if (IsWindowReady())
+        glfwPostEmptyEvent();
+}
+
+void FramePacer::endFrame(bool animating)
+{
+    bool busy = animating || pendingFrames.load() > 0;
+    if (pendingFrames.load() > 0)
+        pendingFrames--;
+
+    if (busy && waiting)
+        DisableEventWaiting();
+    else if (!busy && !waiting)
+        EnableEventWaiting();
+
+    waiting = !busy;
+}
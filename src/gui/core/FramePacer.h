@@ -0,0 +1,21 @@
+#pragma once
+
+#include <atomic>
+
+// Lets the main loop sleep in the windowing system's event wait while nothing is happening. Frames are
+// produced for input events, running animations and explicit requests; wake() may be called from any thread.
+class FramePacer
+{
+public:
+    static void wake(int frames = SETTLE_FRAMES);
+
+    // Called once per frame before EndDrawing, decides whether the next frame waits for an event
+    static void endFrame(bool animating);
+
+private:
+    static std::atomic<int> pendingFrames;
+    static bool waiting;
+
+    // State changes often take one more frame to show up (panel transitions, deferred commands)
+    static constexpr int SETTLE_FRAMES = 2;
+};
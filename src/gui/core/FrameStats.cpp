@@ -0,0 +1,57 @@
+#include "FrameStats.h"
+#include "../../core/logging/Logger.h"
+
+#include <algorithm>
+
+FrameStats::Clock::time_point FrameStats::frameStart;
+FrameStats::Clock::time_point FrameStats::reportStart = FrameStats::Clock::now();
+double FrameStats::totalMs = 0.0;
+double FrameStats::worstMs = 0.0;
+int FrameStats::frames = 0;
+double FrameStats::sinceResetMs = 0.0;
+double FrameStats::sinceResetWorstMs = 0.0;
+int FrameStats::sinceResetFrames = 0;
+
+void FrameStats::beginFrame()
+{
+    frameStart = Clock::now();
+}
+
+void FrameStats::endFrame()
+{
+    auto now = Clock::now();
+    double frameMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+
+    totalMs += frameMs;
+    worstMs = std::max(worstMs, frameMs);
+    frames++;
+
+    sinceResetMs += frameMs;
+    sinceResetWorstMs = std::max(sinceResetWorstMs, frameMs);
+    sinceResetFrames++;
+
+    if (std::chrono::duration<double>(now - reportStart).count() < REPORT_INTERVAL_SECONDS)
+        return;
+
+    LOG_DEBUG("Frame time: avg " << totalMs / frames << " ms, worst " << worstMs << " ms over " << frames << " frames");
+
+    reportStart = now;
+    totalMs = 0.0;
+    worstMs = 0.0;
+    frames = 0;
+}
+
+void FrameStats::reset()
+{
+    sinceResetMs = 0.0;
+    sinceResetWorstMs = 0.0;
+    sinceResetFrames = 0;
+}
+
+FrameStats::Summary FrameStats::summary()
+{
+    if (sinceResetFrames == 0)
+        return Summary();
+
+    return Summary{sinceResetFrames, sinceResetMs / sinceResetFrames, sinceResetWorstMs};
+}
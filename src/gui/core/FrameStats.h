@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+
+// Measures the work GuiManager::render does per frame, excluding the buffer swap and event wait in EndDrawing,
+// and logs the average and worst frame time every few seconds at debug level (BODYA_LOG=debug).
+class FrameStats
+{
+public:
+    struct Summary
+    {
+        int frames = 0;
+        double averageMs = 0.0;
+        double worstMs = 0.0;
+    };
+
+public:
+    static void beginFrame();
+    static void endFrame();
+
+    // Totals since the last reset, kept apart from the periodic log for the frame benchmark in main.cpp
+    static void reset();
+    static Summary summary();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static Clock::time_point frameStart;
+    static Clock::time_point reportStart;
+    static double totalMs;
+    static double worstMs;
+    static int frames;
+
+    static double sinceResetMs;
+    static double sinceResetWorstMs;
+    static int sinceResetFrames;
+
+    static constexpr double REPORT_INTERVAL_SECONDS = 5.0;
+};
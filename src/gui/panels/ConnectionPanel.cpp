@@ -1,11 +1,14 @@
 #include "ConnectionPanel.h"
+#include "../../core/export/CSVImporter.h"
+#include "../../core/export/DatabaseVerifier.h"
 #include "../../core/export/DatabaseExporter.h"
+#include "../../core/export/DirectoryExporter.h"
 #include "../GuiManager.h"
 #include "../include/raygui.h"
 #include "QueryPanel.h"
+#include "../../core/logging/Logger.h"
 #include <cstring>
 #include <fstream>
-#include <iostream>
 
 ConnectionPanel::ConnectionPanel(float startX, float startY, float screenHeight, GuiManager& mgr)
     : screenHeight(screenHeight)
@@ -14,51 +17,96 @@ ConnectionPanel::ConnectionPanel(float startX, float startY, float screenHeight,
     initializePanelLayout(startX, startY);
     setupSubscriptions();
 
-    importDialog.setImportCallback([this](const std::string& path) {
-        std::cout << "Attempting to import from path: " << path << std::endl;
+    importDialog.setImportCallback([this](const std::string& path, const std::string& tableName) {
+        LOG_INFO("Attempting to import from path: " << path);
 
         if (!std::filesystem::exists(path))
         {
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"File not found: " + path, true});
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"File not found: " + path, true});
             return;
         }
 
         auto dbManager = manager.getDatabaseManager().get();
         if (!dbManager)
         {
-            std::cout << "Error: Database manager is null" << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred,
-                                 ErrorData{"Database connection not initialized. Please reconnect to the server.", true});
+            LOG_ERROR("Database manager is null");
+            manager.publishEvent<EventType::ErrorOccurred>(
+                ErrorData{"Database connection not initialized. Please reconnect to the server.", true});
             return;
         }
 
         try
         {
+            if (DirectoryExporter::isDirectoryExport(path))
+            {
+                std::vector<std::string> tables;
+                if (!tableName.empty())
+                    tables.push_back(tableName);
+
+                std::string restored = tableName.empty() ? "database" : tableName;
+
+                if (DirectoryExporter::importFromDirectory(dbManager, path, tables))
+                    manager.publishEvent<EventType::ImportCompleted>(ErrorData{"Restored " + restored + " from " + path, false});
+                else
+                    manager.publishEvent<EventType::ErrorOccurred>(
+                        ErrorData{"Failed to restore from " + path + ". Please check the export manifest.", true});
+                return;
+            }
+
             std::ifstream file(path);
             if (!file.is_open())
             {
-                manager.publishEvent(EventType::ErrorOccurred,
-                                     ErrorData{"Cannot open file: " + path + "\nPlease check file permissions.", true});
+                manager.publishEvent<EventType::ErrorOccurred>(
+                    ErrorData{"Cannot open file: " + path + "\nPlease check file permissions.", true});
                 return;
             }
 
             if (file.peek() == std::ifstream::traits_type::eof())
             {
-                manager.publishEvent(EventType::ErrorOccurred, ErrorData{"The SQL file is empty: " + path, true});
+                manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"The import file is empty: " + path, true});
                 return;
             }
 
             file.close();
 
+            if (CSVImporter::isDelimitedFile(path))
+            {
+                if (tableName.empty())
+                {
+                    manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Please specify the target table for " + path, true});
+                    return;
+                }
+
+                if (tableName.find('.') == std::string::npos)
+                {
+                    manager.publishEvent<EventType::ErrorOccurred>(
+                        ErrorData{"No database is selected, please give the target table as schema.table", true});
+                    return;
+                }
+
+                CSVImporter::Report report;
+                if (CSVImporter::importFromCSV(dbManager, path, tableName, report))
+                    manager.publishEvent<EventType::ImportCompleted>(
+                        ErrorData{"Imported " + std::to_string(report.committedRows) + " rows into " + tableName, false});
+                else if (report.committedRows > 0)
+                    manager.publishEvent<EventType::ErrorOccurred>(
+                        ErrorData{"Import stopped, " + tableName + " keeps the " + std::to_string(report.committedRows) +
+                                      " rows committed before the error (partial import): " + report.error,
+                                  true});
+                else
+                    manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Failed to import " + path + ": " + report.error, true});
+                return;
+            }
+
             if (DatabaseExporter::importFromSQL(dbManager, path))
-                manager.publishEvent(EventType::ImportCompleted, ErrorData{"Database successfully imported from " + path, false});
+                manager.publishEvent<EventType::ImportCompleted>(ErrorData{"Database successfully imported from " + path, false});
             else
-                manager.publishEvent(EventType::ErrorOccurred,
-                                     ErrorData{"Failed to import database. Please check if the SQL file is valid.", true});
+                manager.publishEvent<EventType::ErrorOccurred>(
+                    ErrorData{"Failed to import database. Please check if the SQL file is valid.", true});
         }
         catch (const mysqlx::Error& e)
         {
-            std::cout << "MySQL error during import: " << e.what() << std::endl;
+            LOG_ERROR("MySQL error during import: " << e.what());
             std::string errorMsg = "MySQL Error: ";
 
             if (strstr(e.what(), "Access denied"))
@@ -68,26 +116,49 @@ ConnectionPanel::ConnectionPanel(float startX, float startY, float screenHeight,
             else
                 errorMsg += e.what();
 
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{errorMsg, true});
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{errorMsg, true});
         }
         catch (const std::runtime_error& e)
         {
-            std::cout << "Runtime error during import: " << e.what() << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Import error: " + std::string(e.what()), true});
+            LOG_ERROR("Runtime error during import: " << e.what());
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Import error: " + std::string(e.what()), true});
         }
         catch (const std::exception& e)
         {
-            std::cout << "Exception during import: " << e.what() << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred,
-                                 ErrorData{"Unexpected error during import: " + std::string(e.what()), true});
+            LOG_ERROR("Exception during import: " << e.what());
+            manager.publishEvent<EventType::ErrorOccurred>(
+                ErrorData{"Unexpected error during import: " + std::string(e.what()), true});
         }
         catch (...)
         {
-            std::cout << "Unknown error during import" << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"An unknown error occurred during import", true});
+            LOG_ERROR("Unknown error during import");
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"An unknown error occurred during import", true});
         }
     });
 
+    importDialog.setVerifyCallback([this](const std::string& path) {
+        auto dbManager = manager.getDatabaseManager().get();
+        if (!dbManager)
+        {
+            manager.publishEvent<EventType::ErrorOccurred>(
+                ErrorData{"Database connection not initialized. Please reconnect to the server.", true});
+            return;
+        }
+
+        if (!DirectoryExporter::isDirectoryExport(path))
+        {
+            manager.publishEvent<EventType::ErrorOccurred>(
+                ErrorData{"Verification needs a directory export with a manifest: " + path, true});
+            return;
+        }
+
+        DatabaseVerifier::Report report;
+        if (!DatabaseVerifier::verifyExport(dbManager, path, report))
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Failed to verify against " + path, true});
+        else
+            manager.publishEvent<EventType::ImportCompleted>(ErrorData{report.summary(), !report.passed()});
+    });
+
     importDatabaseBtn = {startX + 20, startY + 400, 120, 30};
 }
 
@@ -131,10 +202,9 @@ void ConnectionPanel::render(bool hasData)
     drawPanelTitle();
     renderCurrentState();
 
-    std::cout << "\nRender conditions for import button:" << std::endl;
-    std::cout << "State is SERVER_CONNECTED: " << (state == ConnectionState::SERVER_CONNECTED) << std::endl;
-    std::cout << "Export dialog not active: " << (!queryPanel->isExportDialogActive()) << std::endl;
-    std::cout << "Import dialog not visible: " << (!importDialog.isVisible()) << std::endl;
+    LOG_TRACE("Import button conditions: server connected " << (state == ConnectionState::SERVER_CONNECTED)
+                                                          << ", export dialog active " << queryPanel->isExportDialogActive()
+                                                          << ", import dialog visible " << importDialog.isVisible());
 
     if (state == ConnectionState::SERVER_CONNECTED && !queryPanel->isExportDialogActive() && !importDialog.isVisible())
     {
@@ -142,10 +212,7 @@ void ConnectionPanel::render(bool hasData)
         Vector2 mousePos = GetMousePosition();
         bool isImportBtnHovered = CheckCollisionPointRec(mousePos, importDatabaseBtn);
 
-        std::cout << "Import button bounds: " << importDatabaseBtn.x << ", " << importDatabaseBtn.y << ", " << importDatabaseBtn.width
-                  << ", " << importDatabaseBtn.height << std::endl;
-        std::cout << "Mouse position: " << mousePos.x << ", " << mousePos.y << std::endl;
-        std::cout << "Button hovered: " << isImportBtnHovered << std::endl;
+        LOG_TRACE("Import button hovered: " << isImportBtnHovered << ", mouse " << mousePos.x << ", " << mousePos.y);
 
         Color importBtnColor = isImportBtnHovered ? Color{0, 100, 180, 255} : Color{0, 120, 210, 255};
 
@@ -282,36 +349,34 @@ void ConnectionPanel::setupSubscriptions()
     auto& bus = EventBus::getInstance();
 
     // Subscribe to ServerConnected events
-    subscriptionIds.push_back({EventType::ServerConnected, bus.subscribe(EventType::ServerConnected, [this](const auto& data) {
-                                   auto* connData = std::any_cast<DatabaseConnectedData>(&data);
-                                   if (connData && connData->success)
+    subscriptionIds.push_back({EventType::ServerConnected, bus.subscribe<EventType::ServerConnected>([this](const auto& data) {
+                                   if (data.success)
                                    {
                                        state = ConnectionState::SERVER_CONNECTED;
                                    }
                                })});
 
     // Subscribe to DatabaseConnected events
-    subscriptionIds.push_back({EventType::DatabaseConnected, bus.subscribe(EventType::DatabaseConnected, [this](const auto& data) {
-                                   auto* connData = std::any_cast<DatabaseConnectedData>(&data);
-                                   if (connData && connData->success)
+    subscriptionIds.push_back({EventType::DatabaseConnected, bus.subscribe<EventType::DatabaseConnected>([this](const auto& data) {
+                                   if (data.success)
                                    {
                                        state = ConnectionState::DATABASE_CONNECTED;
-                                       strcpy(connInfo.dbName, connData->databaseName.c_str());
+                                       strcpy(connInfo.dbName, data.databaseName.c_str());
                                    }
                                })});
 
     // Subscribe to reset events
-    subscriptionIds.push_back({EventType::ServerDisconnected, bus.subscribe(EventType::ServerDisconnected, [this](const auto&) {
+    subscriptionIds.push_back({EventType::ServerDisconnected, bus.subscribe<EventType::ServerDisconnected>([this](const auto&) {
                                    state = ConnectionState::DISCONNECTED;
                                    resetConnection();
                                })});
 
-    subscriptionIds.push_back({EventType::DatabaseDisconnected, bus.subscribe(EventType::DatabaseDisconnected, [this](const auto&) {
+    subscriptionIds.push_back({EventType::DatabaseDisconnected, bus.subscribe<EventType::DatabaseDisconnected>([this](const auto&) {
                                    state = ConnectionState::DISCONNECTED;
                                    resetConnection();
                                })});
 
-    subscriptionIds.push_back({EventType::StateReset, bus.subscribe(EventType::StateReset, [this](const auto&) {
+    subscriptionIds.push_back({EventType::StateReset, bus.subscribe<EventType::StateReset>([this](const auto&) {
                                    state = ConnectionState::DISCONNECTED;
                                    resetConnection();
                                })});
@@ -331,14 +396,14 @@ void ConnectionPanel::resetConnection()
     selectedDbIndex = -1;
     databases.clear();
     databaseListScroll = 0.0f;
+    updateDatabaseList();
     memset(connInfo.dbName, 0, sizeof(connInfo.dbName));
 }
 
 bool ConnectionPanel::isDatabaseSelected() const
 {
     bool selected = selectedDbIndex >= 0 && selectedDbIndex < databases.size();
-    std::cout << "isDatabaseSelected: " << selected << " (index=" << selectedDbIndex << ", dbName=" << connInfo.dbName << ")"
-              << std::endl;
+    LOG_TRACE("isDatabaseSelected: " << selected << " (index=" << selectedDbIndex << ", dbName=" << connInfo.dbName << ")");
     return selected;
 }
 
@@ -346,7 +411,7 @@ std::string ConnectionPanel::getSelectedDatabase() const
 {
     if (selectedDbIndex >= 0 && selectedDbIndex < databases.size())
     {
-        std::cout << "Returning selected database: " << databases[selectedDbIndex] << std::endl;
+        LOG_TRACE("Returning selected database: " << databases[selectedDbIndex]);
         return databases[selectedDbIndex];
     }
     return "";
@@ -373,14 +438,7 @@ bool ConnectionPanel::handleExit() const
 void ConnectionPanel::renderDatabaseSelection()
 {
     if (databaseList && !importDialog.isVisible())
-    {
-        std::vector<ScrollableList::ListItem> items;
-
-        for (size_t i = 0; i < databases.size(); i++)
-            items.push_back({databases[i], static_cast<int>(i) == selectedDbIndex, false});
-
-        databaseList->render(items);
-    }
+        databaseList->render();
 }
 
 void ConnectionPanel::initializeDatabaseList(float startX, float startY)
@@ -393,8 +451,10 @@ void ConnectionPanel::initializeDatabaseList(float startX, float startY)
                                                     32                 
     );
 
-    databaseList->setCallbacks([this](const std::string& dbName) {
+    databaseList->setCallbacks([this](const ScrollableList::ListItem& item) {
+        const std::string& dbName = item.text;
         selectedDbIndex = std::find(databases.begin(), databases.end(), dbName) - databases.begin();
+        databaseList->setSelectedIndex(selectedDbIndex);
         strcpy(connInfo.dbName, dbName.c_str());
         state = ConnectionState::DATABASE_CONNECTED;
     });
@@ -410,11 +470,11 @@ void ConnectionPanel::updateDatabaseList()
 {
     std::vector<ScrollableList::ListItem> items;
 
-    for (const auto& db : databases)
-        items.push_back({db, false, false});
+    for (size_t i = 0; i < databases.size(); i++)
+        items.push_back({databases[i], static_cast<int>(i) == selectedDbIndex, false});
 
     if (databaseList)
-        databaseList->render(items);
+        databaseList->setItems(std::move(items));
 }
 
 void ConnectionPanel::renderConnectionStatus()
@@ -517,18 +577,12 @@ bool ConnectionPanel::shouldImportDatabase()
     bool isOverButton = CheckCollisionPointRec(mousePos, importDatabaseBtn);
     bool isClicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
 
-    std::cout << "\nImport button check:" << std::endl;
-    std::cout << "Mouse position: " << mousePos.x << ", " << mousePos.y << std::endl;
-    std::cout << "Button bounds: " << importDatabaseBtn.x << ", " << importDatabaseBtn.y << ", " << importDatabaseBtn.width << ", "
-              << importDatabaseBtn.height << std::endl;
-    std::cout << "Over button: " << isOverButton << std::endl;
-    std::cout << "Mouse clicked: " << isClicked << std::endl;
-    std::cout << "Current state: " << static_cast<int>(state) << std::endl;
-    std::cout << "Export dialog active: " << (queryPanel && queryPanel->isExportDialogActive()) << std::endl;
+    LOG_TRACE("Import button check: over " << isOverButton << ", clicked " << isClicked << ", state " << static_cast<int>(state)
+                                           << ", export dialog active " << (queryPanel && queryPanel->isExportDialogActive()));
 
     if (state == ConnectionState::SERVER_CONNECTED && !queryPanel->isExportDialogActive() && isOverButton && isClicked)
     {
-        std::cout << "Import button clicked - showing dialog" << std::endl;
+        LOG_DEBUG("Import button clicked - showing dialog");
         importDialog.show();
         return false; 
     }
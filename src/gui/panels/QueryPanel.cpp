@@ -1,13 +1,15 @@
 #include "QueryPanel.h"
 
 #include "../../core/export/DatabaseExporter.h"
+#include "../../core/export/DirectoryExporter.h"
 #include "../GuiManager.h"
 #include "../components/IconRenderer.h"
 #include "../core/EventData.h"
 #include "../core/EventType.h"
+#include "../../core/logging/Logger.h"
 
 #include <cstring>
-#include <iostream>
+#include <filesystem>
 #include <memory>
 
 #include "../include/raygui.h"
@@ -33,48 +35,52 @@ QueryPanel::QueryPanel(float startX, float startY, float width, GuiManager& mgr)
     memset(queryInput, 0, QUERY_BUFFER_SIZE);
     setupSubscriptions();
 
-    exportDialog.setExportCallback([this](const std::string& path, const std::string& filename) {
-        std::cout << "\n=== Export Callback Debug ===" << std::endl;
-        std::cout << "Export callback triggered" << std::endl;
-        std::cout << "Path: " << path << std::endl;
-        std::cout << "Filename: " << filename << std::endl;
+    exportDialog.setExportCallback([this](const std::string& path, const std::string& filename, ExportDialog::Format format,
+                                          const std::string& baseExport) {
+        LOG_DEBUG("Export callback triggered with path " << path << ", filename " << filename);
 
         auto dbManager = manager.getDatabaseManager().get();
         auto tableManager = manager.getTableManager().get();
 
-        std::cout << "Database Manager: " << (dbManager ? "valid" : "null") << std::endl;
-        std::cout << "Table Manager: " << (tableManager ? "valid" : "null") << std::endl;
+        LOG_DEBUG("Database manager: " << (dbManager ? "valid" : "null") << ", table manager: " << (tableManager ? "valid" : "null"));
 
         if (!dbManager || !tableManager)
         {
-            std::cout << "Error: Manager(s) are null" << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Database connection not properly initialized", true});
+            LOG_ERROR("Manager(s) are null");
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Database connection not properly initialized", true});
             return;
         }
 
         std::string fullPath = path + "/" + filename;
-        std::cout << "Full export path: " << fullPath << std::endl;
+
+        // Directory exports are named after the file without its extension
+        if (format == ExportDialog::Format::DIRECTORY)
+            fullPath = (std::filesystem::path(path) / std::filesystem::path(filename).stem()).string();
+
+        LOG_DEBUG("Full export path: " << fullPath);
 
         try
         {
-            std::cout << "Starting export..." << std::endl;
-            bool result = DatabaseExporter::exportToSQL(dbManager, tableManager, fullPath);
-            std::cout << "Export result: " << (result ? "success" : "failure") << std::endl;
+            LOG_DEBUG("Starting export...");
+            bool result = format == ExportDialog::Format::DIRECTORY
+                              ? DirectoryExporter::exportToDirectory(dbManager, fullPath, baseExport)
+                              : DatabaseExporter::exportToSQL(dbManager, tableManager, fullPath);
+            LOG_DEBUG("Export result: " << (result ? "success" : "failure"));
 
             if (result)
-                manager.publishEvent(EventType::ExportCompleted, ErrorData{"Database exported to " + fullPath, false});
+                manager.publishEvent<EventType::ExportCompleted>(ErrorData{"Database exported to " + fullPath, false});
             else
-                manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Failed to export database", true});
+                manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Failed to export database", true});
         }
         catch (const std::exception& e)
         {
-            std::cout << "Exception during export: " << e.what() << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Export error: " + std::string(e.what()), true});
+            LOG_ERROR("Exception during export: " << e.what());
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Export error: " + std::string(e.what()), true});
         }
         catch (...)
         {
-            std::cout << "Unknown exception during export" << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Unknown export error occurred", true});
+            LOG_ERROR("Unknown exception during export");
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Unknown export error occurred", true});
         }
     });
 }
@@ -84,7 +90,7 @@ void QueryPanel::setupSubscriptions()
     auto& bus = EventBus::getInstance();
 
     // Subscribe to DatabaseConnected events
-    subscriptionIds.push_back({EventType::DatabaseConnected, bus.subscribe(EventType::DatabaseConnected, [this](const auto&) {
+    subscriptionIds.push_back({EventType::DatabaseConnected, bus.subscribe<EventType::DatabaseConnected>([this](const auto&) {
                                    clearQuery();
                                    resetObjectsVisibility();
                                    erDiagramVisible = false;
@@ -92,7 +98,7 @@ void QueryPanel::setupSubscriptions()
                                })});
 
     // Subscribe to DatabaseDisconnected events
-    subscriptionIds.push_back({EventType::DatabaseDisconnected, bus.subscribe(EventType::DatabaseDisconnected, [this](const auto&) {
+    subscriptionIds.push_back({EventType::DatabaseDisconnected, bus.subscribe<EventType::DatabaseDisconnected>([this](const auto&) {
                                    clearQuery();
                                    resetObjectsVisibility();
                                    erDiagramVisible = false;
@@ -100,7 +106,7 @@ void QueryPanel::setupSubscriptions()
                                })});
 
     // Subscribe to StateReset events
-    subscriptionIds.push_back({EventType::StateReset, bus.subscribe(EventType::StateReset, [this](const auto&) {
+    subscriptionIds.push_back({EventType::StateReset, bus.subscribe<EventType::StateReset>([this](const auto&) {
                                    clearQuery();
                                    resetObjectsVisibility();
                                    erDiagramVisible = false;
@@ -108,9 +114,8 @@ void QueryPanel::setupSubscriptions()
                                })});
 
     // Subscribe to QueryExecuted events
-    subscriptionIds.push_back({EventType::QueryExecuted, bus.subscribe(EventType::QueryExecuted, [this](const auto& data) {
-                                   auto* queryData = std::any_cast<QueryExecutedData>(&data);
-                                   if (queryData && queryData->success)
+    subscriptionIds.push_back({EventType::QueryExecuted, bus.subscribe<EventType::QueryExecuted>([this](const auto& data) {
+                                   if (data.success)
                                    {
                                        if (!queryFromTableClick && !objectsVisible)
                                            resetObjectsVisibility();
@@ -172,7 +177,7 @@ void QueryPanel::render(bool hasData)
             GuiButton(saveToCSVBtn, "Export CSV");
     }
 
-    std::cout << "Export dialog visible: " << exportDialog.isVisible() << std::endl;
+    LOG_TRACE("Export dialog visible: " << exportDialog.isVisible());
     exportDialog.render();
 }
 
@@ -250,7 +255,7 @@ bool QueryPanel::shouldShowERDiagram()
     bool clicked = CheckCollisionPointRec(GetMousePosition(), showERDiagramBtn) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
     if (clicked)
     {
-        std::cout << "ER Diagram button clicked. Current visibility: " << erDiagramVisible << std::endl;
+        LOG_DEBUG("ER Diagram button clicked. Current visibility: " << erDiagramVisible);
     }
     return clicked;
 }
@@ -267,7 +272,7 @@ bool QueryPanel::shouldExportDatabase()
 
     if (CheckCollisionPointRec(GetMousePosition(), exportDatabaseBtn) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
     {
-        std::cout << "Export button clicked, showing dialog..." << std::endl;
+        LOG_DEBUG("Export button clicked, showing dialog...");
 
         auto dbManager = manager.getDatabaseManager().get();
         if (dbManager)
@@ -281,7 +286,7 @@ bool QueryPanel::shouldExportDatabase()
             }
             catch (const std::exception& e)
             {
-                std::cout << "Error getting database name: " << e.what() << std::endl;
+                LOG_ERROR("Error getting database name: " << e.what());
                 exportDialog.show(); 
             }
         }
@@ -290,7 +295,7 @@ bool QueryPanel::shouldExportDatabase()
             exportDialog.show(); 
         }
 
-        std::cout << "Dialog visibility after show: " << exportDialog.isVisible() << std::endl;
+        LOG_DEBUG("Dialog visibility after show: " << exportDialog.isVisible());
         return false;
     }
     return false;
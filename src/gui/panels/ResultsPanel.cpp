@@ -1,7 +1,6 @@
 #include "ResultsPanel.h"
 #include "QueryPanel.h"
-
-#include <iostream>
+#include "../../core/logging/Logger.h"
 
 #include "../include/raygui.h"
 #include <raylib.h>
@@ -19,15 +18,26 @@ void ResultsPanel::initializeTableList(float startX, float startY)
     float listStartY = startY + 90;
     float titleY = listStartY - 65;
 
-    tableList = std::make_unique<ScrollableList>("Database Objects", startX - 290, listStartY, 230, screenHeight - 450, 32, titleY);
+    // The search box takes the top of the area below the tabs, the list fills the rest
+    objectListTop = listStartY;
+    float searchSpace = SEARCH_BOX_HEIGHT + 6;
+
+    tableList = std::make_unique<ScrollableList>("Database Objects", startX - 290, listStartY + searchSpace, 230,
+                                                 screenHeight - 450 - searchSpace, 32, titleY);
+
+    // Search hits can come from any tab, the tab is switched to the hit's kind so the click handlers see the right type
     tableList->setCallbacks(
-        [this](const std::string& tableName) {
+        [this](const ScrollableList::ListItem& item) {
+            std::string name = item.text;
+            currentTabIndex = static_cast<int>(item.type);
             if (onTableClick)
-                onTableClick(tableName);
+                onTableClick(name);
         },
-        [this](const std::string& tableName) {
+        [this](const ScrollableList::ListItem& item) {
+            std::string name = item.text;
+            currentTabIndex = static_cast<int>(item.type);
             if (onTableStructure)
-                onTableStructure(tableName);
+                onTableStructure(name);
         });
 }
 
@@ -36,35 +46,41 @@ void ResultsPanel::setupSubscriptions()
     auto& bus = EventBus::getInstance();
 
     // Subscribe to QueryExecuted events
-    subscriptionIds.push_back({EventType::QueryExecuted, bus.subscribe(EventType::QueryExecuted, [this](const auto& data) {
-                                   auto* queryData = std::any_cast<QueryExecutedData>(&data);
-                                   if (queryData && queryData->success)
+    subscriptionIds.push_back({EventType::QueryExecuted, bus.subscribe<EventType::QueryExecuted>([this](const auto& data) {
+                                   if (data.success)
                                    {
-                                       currentResult = queryData->result;
+                                       currentResult = data.result;
                                        showTables = false;
+                                       resultGrid.prepare(currentResult);
+                                       resetResultView(currentResult);
+                                   }
+                               })});
+
+    // Further pages of the same result extend the view and the grid layout instead of starting over
+    subscriptionIds.push_back({EventType::QueryRowsAppended, bus.subscribe<EventType::QueryRowsAppended>([this](const auto& data) {
+                                   if (!showTables)
+                                   {
+                                       currentResult = data.result;
+                                       resultView.append(currentResult);
                                    }
                                })});
 
     // Subscribe to TablesLoaded events
-    subscriptionIds.push_back({EventType::TablesLoaded, bus.subscribe(EventType::TablesLoaded, [this](const auto& data) {
-                                   auto* tablesData = std::any_cast<TablesLoadedData>(&data);
-                                   if (tablesData)
+    subscriptionIds.push_back({EventType::TablesLoaded, bus.subscribe<EventType::TablesLoaded>([this](const auto& data) {
+                                   currentTables = data.tables;
+                                   currentViews = data.views;
+                                   currentProcedures = data.procedures;
+                                   currentFunctions = data.functions;
+                                   showTables = data.success;
+                                   if (showTables)
                                    {
-                                       currentTables = tablesData->tables;
-                                       currentViews = tablesData->views;
-                                       currentProcedures = tablesData->procedures;
-                                       currentFunctions = tablesData->functions;
-                                       showTables = tablesData->success;
-                                       if (showTables)
-                                       {
-                                           currentResult = QueryResult();
-                                           updateListContent();
-                                       }
+                                       currentResult = QueryResult();
+                                       rebuildObjectIndex();
                                    }
                                })});
 
     // Subscribe to DatabaseConnected events
-    subscriptionIds.push_back({EventType::DatabaseConnected, bus.subscribe(EventType::DatabaseConnected, [this](const auto&) {
+    subscriptionIds.push_back({EventType::DatabaseConnected, bus.subscribe<EventType::DatabaseConnected>([this](const auto&) {
                                    currentResult = QueryResult();
                                    currentTables.clear();
                                    currentViews.clear();
@@ -72,10 +88,11 @@ void ResultsPanel::setupSubscriptions()
                                    currentFunctions.clear();
                                    showTables = false;
                                    tableListScroll = 0.0f;
+                                   rebuildObjectIndex();
                                })});
 
     // Subscribe to reset events
-    subscriptionIds.push_back({EventType::DatabaseDisconnected, bus.subscribe(EventType::DatabaseDisconnected, [this](const auto&) {
+    subscriptionIds.push_back({EventType::DatabaseDisconnected, bus.subscribe<EventType::DatabaseDisconnected>([this](const auto&) {
                                    currentResult = QueryResult();
                                    currentTables.clear();
                                    currentViews.clear();
@@ -83,6 +100,7 @@ void ResultsPanel::setupSubscriptions()
                                    currentFunctions.clear();
                                    showTables = false;
                                    tableListScroll = 0.0f;
+                                   rebuildObjectIndex();
                                })});
 }
 
@@ -91,16 +109,12 @@ void ResultsPanel::render(bool hasData)
     if (queryPanel && queryPanel->isExportDialogActive())
         return; // Just return without clearing the data
 
+    // Query results are drawn once per frame from GuiManager::renderPanels
     if (showTables && tableList)
     {
-        currentResult = QueryResult(); 
-        renderObjectTabs();
+        currentResult = QueryResult();
         renderTableList(currentTables);
     }
-    else if (!currentResult.columns.empty() && !queryPanel->isExportDialogActive())
-    {
-        renderQueryResults(currentResult);
-    }
 }
 
 void ResultsPanel::renderQueryResults(const QueryResult& result)
@@ -108,112 +122,155 @@ void ResultsPanel::renderQueryResults(const QueryResult& result)
     if (result.columns.empty() || (queryPanel && queryPanel->isExportDialogActive()))
         return;
 
-    DrawRectangleRec(tableBox, RAYWHITE);
+    // A result that arrived without a QueryExecuted event starts over in server order, one that grew is extended
+    if (resultView.totalRows() > result.rows.size())
+        resetResultView(result);
+    else if (resultView.totalRows() < result.rows.size())
+        resultView.append(result);
+
+    Rectangle toolbar = {tableBox.x, tableBox.y, tableBox.width, TOOLBAR_HEIGHT};
+    Rectangle grid = {tableBox.x, tableBox.y + TOOLBAR_HEIGHT, tableBox.width, tableBox.height - TOOLBAR_HEIGHT};
+    renderResultToolbar(toolbar, result);
+
+    if (aggregateActive)
+    {
+        renderAggregateBar(Rectangle{grid.x, grid.y, grid.width, TOOLBAR_HEIGHT}, result);
+        grid.y += TOOLBAR_HEIGHT;
+        grid.height -= TOOLBAR_HEIGHT;
+
+        refreshAggregate(result);
+        aggregateGrid.render(grid, aggregateResult, aggregateView);
+
+        int column = aggregateGrid.getClickedColumn();
+        if (column >= 0)
+            aggregateView.sort(aggregateResult, column, aggregateView.nextOrder(column));
+        return;
+    }
+
+    resultGrid.render(grid, result, resultView);
 
-    int padding = 5;
-    float startX = tableBox.x + padding;
-    float startY = tableBox.y + padding + 20;
+    int column = resultGrid.getClickedColumn();
+    if (column >= 0)
+        resultView.sort(result, column, resultView.nextOrder(column));
+}
 
-    std::vector<int> colWidths = calculateColumnWidths(result, padding);
+void ResultsPanel::renderResultToolbar(Rectangle bounds, const QueryResult& result)
+{
+    float y = bounds.y + 2;
+    float height = bounds.height - 6;
 
-    float totalWidth = 0;
-    for (const auto& width : colWidths)
-        totalWidth += width;
+    DrawText("Filter:", bounds.x + 5, y + (height - 16) / 2, 16, DARKGRAY);
 
-    float rowHeight = 20;
-    float totalHeight = rowHeight;
-    for (const auto& row : result.rows)
+    Rectangle input = {bounds.x + 60, y, 260, height};
+    DrawRectangleRec(input, WHITE);
+    if (GuiTextBox(input, filterInput, sizeof(filterInput), filterActive))
+        filterActive = !filterActive;
+
+    if (GuiButton(Rectangle{input.x + input.width + 5, y, 60, height}, "Clear"))
     {
-        float currentRowHeight = 20;
-        for (const auto& cell : row)
-        {
-            size_t newlines = std::count(cell.begin(), cell.end(), '\n');
-            float cellHeight = (newlines + 1) * 20.0f;
-            currentRowHeight = std::max(currentRowHeight, cellHeight);
-        }
-        totalHeight += currentRowHeight;
+        filterInput[0] = '\0';
+        filterActive = false;
     }
 
-    // Handle horizontal scrolling
-    static float scrollX = 0;
-    if (totalWidth > tableBox.width)
+    if (resultView.getFilterText() != filterInput)
     {
-        float maxScrollX = totalWidth - tableBox.width + padding * 2;
-        scrollX = std::min(scrollX, maxScrollX);
+        resultView.filter(result, filterInput);
+        resultGrid.resetScroll();
+    }
 
-        if (CheckCollisionPointRec(GetMousePosition(), tableBox))
-        {
-            if (IsKeyDown(KEY_LEFT_CONTROL))
-            {
-                scrollX -= GetMouseWheelMove() * 20;
-                scrollX = std::max(0.0f, std::min(scrollX, maxScrollX));
-            }
-        }
+    std::string count = std::to_string(resultView.size()) + " of " + std::to_string(resultView.totalRows()) + " rows";
+    if (aggregateActive)
+        count += ", " + std::to_string(aggregateResult.rows.size()) + " groups";
+    DrawText(count.c_str(), input.x + input.width + 75, y + (height - 16) / 2, 16, DARKGRAY);
 
-        float scrollBarWidth = (tableBox.width / totalWidth) * tableBox.width;
-        float scrollBarX = tableBox.x + (scrollX / totalWidth) * (tableBox.width - scrollBarWidth);
-        DrawRectangle(tableBox.x, tableBox.y + tableBox.height - 8, tableBox.width, 8, Color{235, 235, 235, 255});
-        DrawRectangle(scrollBarX, tableBox.y + tableBox.height - 8, scrollBarWidth, 8, Color{180, 180, 180, 255});
+    if (GuiButton(Rectangle{bounds.x + bounds.width - 95, y, 90, height}, aggregateActive ? "Rows" : "Group by"))
+    {
+        aggregateActive = !aggregateActive;
+        aggregateDirty = true;
     }
+}
 
-    // Handle vertical scrolling
-    static float scrollY = 0;
-    if (totalHeight > tableBox.height)
+void ResultsPanel::renderAggregateBar(Rectangle bounds, const QueryResult& result)
+{
+    auto& spec = aggregateSpec;
+    int columns = static_cast<int>(result.columns.size());
+    if (static_cast<int>(spec.groupColumn) >= columns || spec.pivotColumn >= columns || spec.valueColumn >= columns)
     {
-        float maxScrollY = totalHeight - tableBox.height + padding * 2;
-        scrollY = std::min(scrollY, maxScrollY);
+        spec = ResultAggregator::Spec();
+        aggregateDirty = true;
+    }
 
-        if (CheckCollisionPointRec(GetMousePosition(), tableBox))
-        {
-            if (!IsKeyDown(KEY_LEFT_CONTROL))
-            {
-                scrollY -= GetMouseWheelMove() * 20;
-                scrollY = std::max(0.0f, std::min(scrollY, maxScrollY));
-            }
-        }
+    auto columnName = [&result](int column) { return column >= 0 ? result.columns[column] : std::string("none"); };
+
+    float y = bounds.y + 2;
+    float height = bounds.height - 6;
+    float width = std::min(200.0f, (bounds.width - 10) / 4 - 5);
+    float x = bounds.x + 5;
 
-        float scrollBarHeight = (tableBox.height / totalHeight) * tableBox.height;
-        float scrollBarY = tableBox.y + (scrollY / totalHeight) * (tableBox.height - scrollBarHeight);
-        DrawRectangle(tableBox.x + tableBox.width - 8, tableBox.y, 8, tableBox.height, Color{235, 235, 235, 255});
-        DrawRectangle(tableBox.x + tableBox.width - 8, scrollBarY, 8, scrollBarHeight, Color{180, 180, 180, 255});
+    // Each button steps through its choices, the aggregate is recomputed on the next refresh
+    std::string group = "By: " + columnName(static_cast<int>(spec.groupColumn));
+    if (GuiButton(Rectangle{x, y, width, height}, group.c_str()))
+    {
+        spec.groupColumn = nextColumn(static_cast<int>(spec.groupColumn), result.columns.size(), false);
+        aggregateDirty = true;
     }
 
-    BeginScissorMode(tableBox.x, tableBox.y, tableBox.width - 8, tableBox.height - 8);
+    x += width + 5;
+    std::string pivot = "Pivot: " + columnName(spec.pivotColumn);
+    if (GuiButton(Rectangle{x, y, width, height}, pivot.c_str()))
+    {
+        spec.pivotColumn = nextColumn(spec.pivotColumn, result.columns.size(), true);
+        aggregateDirty = true;
+    }
 
-    // Draw header
-    float currentX = startX - scrollX;
-    for (size_t i = 0; i < result.columns.size(); ++i)
+    x += width + 5;
+    std::string value = "Value: " + (spec.valueColumn >= 0 ? result.columns[spec.valueColumn] : std::string("*"));
+    if (GuiButton(Rectangle{x, y, width, height}, value.c_str()))
     {
-        drawTableCell(currentX, tableBox.y + padding - scrollY, colWidths[i], GRAY, result.columns[i].c_str(), padding);
-        currentX += colWidths[i];
+        spec.valueColumn = nextColumn(spec.valueColumn, result.columns.size(), true);
+        aggregateDirty = true;
     }
 
-    // Draw rows
-    float currentY = startY - scrollY;
-    for (const auto& row : result.rows)
+    x += width + 5;
+    if (GuiButton(Rectangle{x, y, width, height}, ResultAggregator::functionName(spec.function)))
     {
-        float rowHeight = 20;
+        spec.function = static_cast<ResultAggregator::Function>((static_cast<int>(spec.function) + 1) % 5);
+        aggregateDirty = true;
+    }
+}
 
-        for (const auto& cell : row)
-        {
-            size_t newlines = std::count(cell.begin(), cell.end(), '\n');
-            float cellHeight = (newlines + 1) * 20.0f;
-            rowHeight = std::max(rowHeight, cellHeight);
-        }
+void ResultsPanel::refreshAggregate(const QueryResult& result)
+{
+    // The aggregate follows the filter, so narrowing the rows slices the groups as well
+    if (!aggregateDirty && aggregatedViewVersion == resultView.getVersion())
+        return;
 
-        currentX = startX - scrollX;
-        for (size_t i = 0; i < row.size(); ++i)
-        {
-            if (i >= colWidths.size())
-                break;
+    aggregateResult = ResultAggregator::aggregate(result, resultView.rows(), aggregateSpec);
+    aggregateView.reset(aggregateResult);
+    aggregateGrid.prepare(aggregateResult);
+    aggregateGrid.resetScroll();
 
-            drawTableCell(currentX, currentY, colWidths[i], RAYWHITE, row[i].c_str(), padding, rowHeight);
-            currentX += colWidths[i];
-        }
-        currentY += rowHeight;
-    }
+    aggregateDirty = false;
+    aggregatedViewVersion = resultView.getVersion();
+}
+
+int ResultsPanel::nextColumn(int current, size_t columnCount, bool allowNone)
+{
+    int next = current + 1;
+    if (next < static_cast<int>(columnCount))
+        return next;
+    return allowNone ? -1 : 0;
+}
 
-    EndScissorMode();
+void ResultsPanel::resetResultView(const QueryResult& result)
+{
+    resultView.reset(result);
+    aggregateActive = false;
+    aggregateDirty = true;
+    aggregateSpec = ResultAggregator::Spec();
+    filterInput[0] = '\0';
+    filterActive = false;
+    resultGrid.resetScroll();
 }
 
 void ResultsPanel::renderTableList(const std::vector<std::string>& tables)
@@ -224,7 +281,8 @@ void ResultsPanel::renderTableList(const std::vector<std::string>& tables)
     if (tableList)
     {
         renderObjectTabs();
-        updateListContent();
+        renderObjectSearch();
+        tableList->render();
     }
 }
 
@@ -235,54 +293,12 @@ bool ResultsPanel::isMouseOverTable(float y, float height) const
            mousePos.y <= y + height;
 }
 
-void ResultsPanel::drawTableCell(float x, float y, float width, Color bgColor, const char* text, int padding, float height)
-{
-    DrawRectangle(x, y, width, height, bgColor);
-    DrawRectangleLines(x, y, width, height, BLACK);
-
-    std::string str(text);
-    float lineHeight = 20;
-    float currentY = y + 2;
-
-    size_t pos = 0;
-    std::string line;
-    while ((pos = str.find('\n')) != std::string::npos)
-    {
-        line = str.substr(0, pos);
-        DrawText(line.c_str(), x + padding, currentY, 18, DARKGRAY);
-        currentY += lineHeight;
-        str = str.substr(pos + 1);
-    }
-
-    if (!str.empty())
-        DrawText(str.c_str(), x + padding, currentY, 18, DARKGRAY);
-}
-
-std::vector<int> ResultsPanel::calculateColumnWidths(const QueryResult& result, int padding)
-{
-    std::vector<int> colWidths;
-    for (const auto& col : result.columns)
-    {
-        int width = MeasureText(col.c_str(), 18) + padding * 2;
-        for (const auto& row : result.rows)
-        {
-            if (colWidths.size() >= row.size())
-                break;
-
-            int cellWidth = MeasureText(row[colWidths.size()].c_str(), 18) + padding * 2;
-            width = std::max(width, cellWidth);
-        }
-        colWidths.push_back(width);
-    }
-    return colWidths;
-}
-
 void ResultsPanel::renderObjectTabs()
 {
     float tabWidth = 55;
     float tabHeight = 22;
     float startX = tableList->getBounds().x;
-    float startY = tableList->getBounds().y - tabHeight - 5;
+    float startY = objectListTop - tabHeight - 5;
     float totalWidth = tabWidth * 4;
 
     startX = startX + (tableList->getBounds().width - totalWidth) / 2;
@@ -315,24 +331,87 @@ void ResultsPanel::renderObjectTabs()
         int textWidth = MeasureText(tabs[i], 14);
         DrawText(tabs[i], tabRect.x + (tabRect.width - textWidth) / 2, tabRect.y + 4, 14, Color{70, 70, 70, 255});
 
-        if (isHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        if (isHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && currentTabIndex != i)
         {
             currentTabIndex = i;
+            tableList->setScroll(0.0f);
             updateListContent();
         }
     }
 }
 
+void ResultsPanel::renderObjectSearch()
+{
+    Rectangle bounds = tableList->getBounds();
+    Rectangle input = {bounds.x, objectListTop, bounds.width, SEARCH_BOX_HEIGHT};
+
+    DrawRectangleRec(input, WHITE);
+    if (GuiTextBox(input, searchInput, sizeof(searchInput), searchActive))
+        searchActive = !searchActive;
+
+    if (searchInput[0] == '\0' && !searchActive)
+        DrawText("Search all objects...", input.x + 8, input.y + (input.height - 14) / 2, 14, GRAY);
+
+    // Each keystroke re-ranks from the index, extending the query only rescans the previous hits
+    if (appliedSearch != searchInput)
+    {
+        appliedSearch = searchInput;
+        tableList->setScroll(0.0f);
+        updateListContent();
+    }
+}
+
+void ResultsPanel::rebuildObjectIndex()
+{
+    objectEntries.clear();
+    objectEntries.reserve(currentTables.size() + currentViews.size() + currentProcedures.size() + currentFunctions.size());
+
+    auto addEntries = [this](const std::vector<std::string>& names, ScrollableList::DatabaseObjectType type) {
+        for (const auto& name : names)
+            objectEntries.push_back({name, type});
+    };
+    addEntries(currentTables, ScrollableList::DatabaseObjectType::Table);
+    addEntries(currentViews, ScrollableList::DatabaseObjectType::View);
+    addEntries(currentProcedures, ScrollableList::DatabaseObjectType::StoredProcedure);
+    addEntries(currentFunctions, ScrollableList::DatabaseObjectType::Function);
+
+    std::vector<std::string> names;
+    names.reserve(objectEntries.size());
+    for (const auto& entry : objectEntries)
+        names.push_back(entry.name);
+    objectIndex.build(names);
+
+    updateListContent();
+}
+
 void ResultsPanel::updateListContent()
 {
     if (!tableList)
         return;
 
+    // Rebuilt only when the objects, the tab or the search change, the list keeps the items between frames
     std::vector<ScrollableList::ListItem> items;
 
+    if (!appliedSearch.empty())
+    {
+        static const char* tags[] = {"table", "view", "proc", "func"};
+
+        for (const auto& match : objectIndex.search(appliedSearch, MAX_SEARCH_RESULTS))
+        {
+            const auto& entry = objectEntries[match.id];
+            bool hasStructure = entry.type == ScrollableList::DatabaseObjectType::Table ||
+                                entry.type == ScrollableList::DatabaseObjectType::View;
+            items.push_back({entry.name, false, hasStructure, entry.type, tags[static_cast<int>(entry.type)]});
+        }
+
+        tableList->setItems(std::move(items));
+        return;
+    }
+
     switch (currentTabIndex)
     {
     case 0: // Tables
+        items.reserve(currentTables.size());
         for (const auto& table : currentTables)
         {
             items.push_back({table, false, true, ScrollableList::DatabaseObjectType::Table});
@@ -340,6 +419,7 @@ void ResultsPanel::updateListContent()
         break;
 
     case 1: // Views
+        items.reserve(currentViews.size());
         for (const auto& view : currentViews)
         {
             items.push_back({view, false, true, ScrollableList::DatabaseObjectType::View});
@@ -347,6 +427,7 @@ void ResultsPanel::updateListContent()
         break;
 
     case 2: // Procedures
+        items.reserve(currentProcedures.size());
         for (const auto& proc : currentProcedures)
         {
             items.push_back({proc, false, false, ScrollableList::DatabaseObjectType::StoredProcedure});
@@ -354,6 +435,7 @@ void ResultsPanel::updateListContent()
         break;
 
     case 3: // Functions
+        items.reserve(currentFunctions.size());
         for (const auto& func : currentFunctions)
         {
             items.push_back({func, false, false, ScrollableList::DatabaseObjectType::Function});
@@ -361,9 +443,9 @@ void ResultsPanel::updateListContent()
         break;
     }
 
-    std::cout << "Updating list content with: " << items.size() << " items for tab " << currentTabIndex << std::endl;
-    std::cout << "Tables: " << currentTables.size() << ", Views: " << currentViews.size()
-              << ", Procedures: " << currentProcedures.size() << ", Functions: " << currentFunctions.size() << std::endl;
+    LOG_DEBUG("Object list now has " << items.size() << " items for tab " << currentTabIndex << " (tables: " << currentTables.size()
+                                     << ", views: " << currentViews.size() << ", procedures: " << currentProcedures.size()
+                                     << ", functions: " << currentFunctions.size() << ")");
 
-    tableList->render(items);
+    tableList->setItems(std::move(items));
 }
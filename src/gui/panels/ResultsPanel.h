@@ -1,7 +1,11 @@
 #pragma once
 
+#include "../../core/results/ResultAggregator.h"
+#include "../../core/results/ResultView.h"
+#include "../../core/search/FuzzyIndex.h"
 #include "../../models/QueryResult.h"
 #include "../components/IconRenderer.h"
+#include "../components/ResultGrid.h"
 #include "../components/ScrollableList.h"
 #include "../core/EventData.h"
 #include "../core/EventType.h"
@@ -61,16 +65,23 @@ private:
     void handleTablesLoaded(const std::vector<std::string>* tables);
     void handleDatabaseDisconnected();
 
-    void drawTableCell(float x, float y, float width, Color bgColor, const char* text, int padding, float height = 20);
-    std::vector<int> calculateColumnWidths(const QueryResult& result, int padding);
     bool isMouseOverTable(float y, float height) const;
 
     void initializeTableList(float startX, float startY);
     void updateTableList();
 
     void renderObjectTabs();
+    void renderObjectSearch();
+    void rebuildObjectIndex();
     void updateListContent();
 
+    void renderResultToolbar(Rectangle bounds, const QueryResult& result);
+    void resetResultView(const QueryResult& result);
+    void renderAggregateBar(Rectangle bounds, const QueryResult& result);
+    void refreshAggregate(const QueryResult& result);
+
+    static int nextColumn(int current, size_t columnCount, bool allowNone);
+
 private:
     Rectangle tableBox;
     Rectangle tableNamesBox;
@@ -86,20 +97,47 @@ private:
     std::vector<std::string> currentFunctions;
     int currentTabIndex = 0;
 
+    // Every object of all four kinds, searched together from the box above the list
+    struct ObjectEntry
+    {
+        std::string name;
+        ScrollableList::DatabaseObjectType type;
+    };
+    std::vector<ObjectEntry> objectEntries;
+    FuzzyIndex objectIndex;
+    char searchInput[128] = "";
+    bool searchActive = false;
+    std::string appliedSearch;
+    float objectListTop = 0.0f;
+
 private:
     static constexpr float TABLE_LIST_WIDTH = 200.0f;
     static constexpr float TABLE_ITEM_HEIGHT = 25.0f;
     static constexpr float TABLE_LIST_START_Y = 120.0f;
     static constexpr float TABLE_LIST_HEIGHT = 300.0f;
     static constexpr float STRUCTURE_BUTTON_WIDTH = 35.0f;
+    static constexpr float TOOLBAR_HEIGHT = 34.0f;
+    static constexpr float SEARCH_BOX_HEIGHT = 28.0f;
+    static constexpr size_t MAX_SEARCH_RESULTS = 1000;
 
 private:
     float screenHeight;
     std::unique_ptr<ScrollableList> tableList;
     bool showTables = false;
 
-    float scrollX = 0;
-    float scrollY = 0;
+    ResultGrid resultGrid;
+    ResultView resultView;
+    char filterInput[256] = "";
+    bool filterActive = false;
+
+    // Client-side GROUP BY / pivot over the filtered rows, shown in its own grid
+    bool aggregateActive = false;
+    bool aggregateDirty = true;
+    uint64_t aggregatedViewVersion = 0;
+    ResultAggregator::Spec aggregateSpec;
+    QueryResult aggregateResult;
+    ResultView aggregateView;
+    ResultGrid aggregateGrid;
 
 private:
     std::shared_ptr<QueryPanel> queryPanel;
@@ -3,8 +3,7 @@
 #include "../GuiManager.h"
 #include "../commands/CommandFactory.h"
 #include "../core/export/DatabaseExporter.h"
-
-#include <iostream>
+#include "../../core/logging/Logger.h"
 
 void DisconnectedState::render(GuiManager& manager)
 {
@@ -47,11 +46,11 @@ void ConnectedState::handleInput(GuiManager& manager)
     {
 
         std::string selectedDb = panel->getSelectedDatabase();
-        std::cout << "Selected database: " << selectedDb << std::endl;
+        LOG_INFO("Selected database: " << selectedDb);
 
         if (!selectedDb.empty())
         {
-            std::cout << "Initiating database connection..." << std::endl;
+            LOG_INFO("Initiating database connection...");
 
             auto command = std::make_unique<ConnectToDatabaseCommand>(manager.getDatabaseManager(), manager.getTableManager(),
                                                                       manager.getQuery(), selectedDb);
@@ -61,13 +60,13 @@ void ConnectedState::handleInput(GuiManager& manager)
 
             if (manager.verifyDatabaseConnection())
             {
-                std::cout << "Database connection successful, all objects initialized" << std::endl;
+                LOG_INFO("Database connection successful, all objects initialized");
                 manager.setConnected(true);
             }
             else
             {
-                std::cout << "Failed to initialize database connection objects" << std::endl;
-                manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Failed to initialize database connection", true});
+                LOG_ERROR("Failed to initialize database connection objects");
+                manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Failed to initialize database connection", true});
 
                 manager.resetDatabaseManager();
                 manager.resetTableManager();
@@ -101,8 +100,8 @@ void QueryState::handleInput(GuiManager& manager)
     {
         if (!manager.verifyDatabaseConnection())
         {
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Database connection not properly initialized", true});
-            std::cout << "Database verification failed in QueryState" << std::endl;
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Database connection not properly initialized", true});
+            LOG_ERROR("Database verification failed in QueryState");
             return;
         }
 
@@ -111,7 +110,7 @@ void QueryState::handleInput(GuiManager& manager)
             std::string queryText = queryPanel->getQueryText();
             if (queryText.empty())
             {
-                manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Query cannot be empty", false});
+                manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Query cannot be empty", false});
                 return;
             }
 
@@ -121,7 +120,7 @@ void QueryState::handleInput(GuiManager& manager)
         }
         catch (const std::exception& e)
         {
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{std::string("Query error: ") + e.what(), true});
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{std::string("Query error: ") + e.what(), true});
         }
     }
 
@@ -143,14 +142,13 @@ void QueryState::handleInput(GuiManager& manager)
             else
             {
                 latestTableResult.tableNames.clear();
-                manager.publishEvent(EventType::TablesLoaded,
-                                     TablesLoadedData{std::vector<std::string>(), std::vector<std::string>(),
+                manager.publishEvent<EventType::TablesLoaded>(TablesLoadedData{std::vector<std::string>(), std::vector<std::string>(),
                                                       std::vector<std::string>(), std::vector<std::string>(), false});
             }
         }
         catch (const std::exception& e)
         {
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{e.what(), true});
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{e.what(), true});
             auto& latestTableResult = manager.getLatestTableResult();
             latestTableResult.isVisible = false;
             queryPanel->setObjectsVisibility(false);
@@ -161,83 +159,22 @@ void QueryState::handleInput(GuiManager& manager)
     {
         try
         {
-            std::cout << "Handling ER Diagram toggle in ApplicationState" << std::endl;
+            LOG_DEBUG("Handling ER Diagram toggle in ApplicationState");
             bool newVisibility = !manager.getERDiagram()->getVisible();
-            std::cout << "Setting new visibility to: " << newVisibility << std::endl;
+            LOG_DEBUG("Setting new visibility to: " << newVisibility);
 
             queryPanel->setERDiagramVisibility(newVisibility);
             manager.getERDiagram()->setVisible(newVisibility);
 
             if (newVisibility)
-            {
-                std::cout << "Loading database structure..." << std::endl;
-                auto tableManager = manager.getTableManager().get();
-
-                if (!tableManager)
-                    throw std::runtime_error("Table manager not initialized");
-
-                manager.getERDiagram()->clear();
-                auto tables = tableManager->getTableNames();
-                std::cout << "Found " << tables.size() << " tables" << std::endl;
-
-                for (const auto& tableName : tables)
-                {
-                    auto structure = tableManager->getTableStructure(tableName);
-
-                    std::vector<ERDiagram::TableColumn> columns;
-                    for (const auto& [colName, colType] : structure)
-                    {
-                        std::string query = "SELECT REFERENCED_TABLE_NAME, REFERENCED_COLUMN_NAME "
-                                            "FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE "
-                                            "WHERE TABLE_SCHEMA = DATABASE() "
-                                            "AND TABLE_NAME = '" +
-                                            tableName +
-                                            "' "
-                                            "AND COLUMN_NAME = '" +
-                                            colName +
-                                            "' "
-                                            "AND REFERENCED_TABLE_NAME IS NOT NULL";
-
-                        auto result = manager.getQuery()->execute(query);
-
-                        bool isForeignKey = !result.rows.empty();
-                        std::string refTable, refColumn;
-                        if (isForeignKey)
-                        {
-                            refTable = result.rows[0][0];
-                            refColumn = result.rows[0][1];
-                        }
-
-                        query = "SELECT COUNT(*) "
-                                "FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE "
-                                "WHERE TABLE_SCHEMA = DATABASE() "
-                                "AND TABLE_NAME = '" +
-                                tableName +
-                                "' "
-                                "AND COLUMN_NAME = '" +
-                                colName +
-                                "' "
-                                "AND CONSTRAINT_NAME = 'PRIMARY'";
-
-                        result = manager.getQuery()->execute(query);
-                        bool isPrimaryKey = !result.rows.empty() && result.rows[0][0] != "0";
-
-                        columns.push_back({colName, colType, isPrimaryKey, isForeignKey, refTable, refColumn});
-                    }
-
-                    manager.getERDiagram()->addTable(tableName, columns);
-                }
-            }
+                manager.openDiagram();
             else
-            {
-                std::cout << "Clearing ER Diagram" << std::endl;
-                manager.getERDiagram()->clear();
-            }
+                manager.getERDiagram()->saveLayout();
         }
         catch (const std::exception& e)
         {
-            std::cout << "Error in ER Diagram handling: " << e.what() << std::endl;
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{e.what(), true});
+            LOG_ERROR("Error in ER Diagram handling: " << e.what());
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{e.what(), true});
             queryPanel->setERDiagramVisibility(false);
             manager.getERDiagram()->setVisible(false);
         }
@@ -250,13 +187,13 @@ void QueryState::handleInput(GuiManager& manager)
             std::string filename = "exports/database_" + std::to_string(std::time(nullptr)) + ".sql";
 
             if (DatabaseExporter::exportToSQL(manager.getDatabaseManager().get(), manager.getTableManager().get(), filename))
-                manager.publishEvent(EventType::ExportCompleted, ErrorData{"Database exported to " + filename, false});
+                manager.publishEvent<EventType::ExportCompleted>(ErrorData{"Database exported to " + filename, false});
             else
                 throw std::runtime_error("Failed to export database");
         }
         catch (const std::exception& e)
         {
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Export failed: " + std::string(e.what()), true});
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Export failed: " + std::string(e.what()), true});
         }
     }
 
@@ -267,13 +204,13 @@ void QueryState::handleInput(GuiManager& manager)
             std::string filename = "imports/database.sql";
 
             if (DatabaseExporter::importFromSQL(manager.getDatabaseManager().get(), filename))
-                manager.publishEvent(EventType::ExportCompleted, ErrorData{"Database imported from " + filename, false});
+                manager.publishEvent<EventType::ExportCompleted>(ErrorData{"Database imported from " + filename, false});
             else
                 throw std::runtime_error("Failed to import database");
         }
         catch (const std::exception& e)
         {
-            manager.publishEvent(EventType::ErrorOccurred, ErrorData{"Import failed: " + std::string(e.what()), true});
+            manager.publishEvent<EventType::ErrorOccurred>(ErrorData{"Import failed: " + std::string(e.what()), true});
         }
     }
 }
@@ -1,10 +1,58 @@
 #include "gui/GuiManager.h"
+#include "gui/core/FramePacer.h"
+#include "gui/core/FrameStats.h"
+
+#include "core/logging/Logger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
 #include <mysqlx/xdevapi.h>
 
-#include <iostream>
+// bodya-sql --bench-frames [frames] [rows]
+// Renders the same frames once with no result and once with a large result held by GuiManager. Holding a result
+// must not cost anything per frame, so both runs should report about the same frame times.
+static void runFrameBenchmark(GuiManager& gui, int frames, size_t rows)
+{
+    SetTargetFPS(0);
+
+    auto measure = [&gui, frames]() {
+        FrameStats::reset();
+
+        bool shouldClose = false;
+        for (int i = 0; i < frames && !WindowShouldClose() && !shouldClose; ++i)
+        {
+            // Keeps the pacer from waiting for input between frames
+            FramePacer::wake();
+            gui.render(shouldClose);
+        }
+
+        return FrameStats::summary();
+    };
+
+    FrameStats::Summary empty = measure();
+
+    auto& result = gui.getLatestQueryResult().data;
+    result.columns = {"id", "name", "email", "created_at", "amount", "status", "country", "note"};
+    for (size_t i = 0; i < rows; ++i)
+    {
+        std::string id = std::to_string(i);
+        result.rows.push_back({id, "customer " + id, "customer" + id + "@example.com", "2024-01-01 12:00:00",
+                               std::to_string(i % 10000) + ".99", i % 3 ? "active" : "closed", "UA",
+                               "a note long enough to live outside the small string buffer"});
+    }
+
+    FrameStats::Summary held = measure();
 
-int main()
+    std::printf("Frame benchmark, work per frame without the buffer swap\n");
+    std::printf("  no result held: %d frames, avg %.3f ms, worst %.3f ms\n", empty.frames, empty.averageMs, empty.worstMs);
+    std::printf("  %zu rows held: %d frames, avg %.3f ms, worst %.3f ms\n", rows, held.frames, held.averageMs, held.worstMs);
+
+    result = QueryResult();
+}
+
+int main(int argc, char* argv[])
 {
     try
     {
@@ -14,32 +62,36 @@ int main()
         GuiManager gui(screenWidth, screenHeight);
         gui.initialize();
 
-        bool shouldClose = false;
-
-        LatestQueryResult latestResult;
+        if (argc > 1 && std::string(argv[1]) == "--bench-frames")
+        {
+            int frames = argc > 2 ? std::atoi(argv[2]) : 600;
+            size_t rows = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200000;
 
-        LatestTableResult latestTableResult;
+            runFrameBenchmark(gui, frames, rows);
+            CloseWindow();
+            return 0;
+        }
 
-        Message errorMsg = {"", true};
+        bool shouldClose = false;
 
         while (!WindowShouldClose() && !shouldClose)
-            gui.render(shouldClose, latestResult, latestTableResult, errorMsg);
+            gui.render(shouldClose);
 
         CloseWindow();
     }
     catch (const mysqlx::Error& err)
     {
-        std::cerr << "MySQL Connector/C++ Error: " << err.what() << std::endl;
+        LOG_ERROR("MySQL Connector/C++ Error: " << err.what());
         return 1;
     }
     catch (const std::exception& ex)
     {
-        std::cerr << "STD Error: " << ex.what() << std::endl;
+        LOG_ERROR("STD Error: " << ex.what());
         return 1;
     }
     catch (...)
     {
-        std::cerr << "Unknown error!" << std::endl;
+        LOG_ERROR("Unknown error!");
         return 1;
     }
 
@@ -1,9 +1,11 @@
 #pragma once
+#include "ResultRows.h"
+
 #include <string>
 #include <vector>
 
 struct QueryResult
 {
     std::vector<std::string> columns;
-    std::vector<std::vector<std::string>> rows;
+    ResultRows rows;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Row storage for a QueryResult, split into fixed-size pages held by shared_ptr. Copies share the pages,
+// so handing a large result to another panel or event costs one pointer per page instead of every string.
+// Full pages are never modified again; appending to a partly filled page that is shared copies that page first.
+class ResultRows
+{
+public:
+    using Row = std::vector<std::string>;
+    using Page = std::vector<Row>;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Row;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Row*;
+        using reference = const Row&;
+
+        const_iterator(const ResultRows* rows, size_t index)
+            : rows(rows)
+            , index(index)
+        {
+        }
+
+        reference operator*() const { return (*rows)[index]; }
+        pointer operator->() const { return &(*rows)[index]; }
+        const_iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+    private:
+        const ResultRows* rows;
+        size_t index;
+    };
+
+public:
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t pageCount() const { return pages.size(); }
+
+    const Row& operator[](size_t index) const { return (*pages[index / PAGE_ROWS])[index % PAGE_ROWS]; }
+
+    void push_back(Row row)
+    {
+        if (count % PAGE_ROWS == 0)
+        {
+            pages.push_back(std::make_shared<Page>());
+            pages.back()->reserve(PAGE_ROWS);
+        }
+        else if (pages.back().use_count() > 1)
+        {
+            pages.back() = std::make_shared<Page>(*pages.back());
+        }
+
+        pages.back()->push_back(std::move(row));
+        count++;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+public:
+    static constexpr size_t PAGE_ROWS = 4096;
+
+private:
+    std::vector<std::shared_ptr<Page>> pages;
+    size_t count = 0;
+};